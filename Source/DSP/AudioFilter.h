@@ -6,6 +6,8 @@
 #include "BiquadParameters.h"
 #include "AudioFilterParameters.h"
 #include "Biquad.h"
+#include "AudioFilterCoefficientTable.h"
+#include "AudioFilterDesigns.h"
 #include "Utilities.h"
 
 /**
@@ -19,13 +21,18 @@ Audio I/O:
 
 Control I/F:
 - Use AudioFilterParameters structure to get/set object params.
+- Template parameter SampleType is the type (float or double) of the audio; the filter designs are always done in double,
+  by the design functions in AudioFilterDesigns.h (which also design many filters at once with designFilters( )).
+- Optionally, the kLowShelf, kHiShelf and kCQParaEQ designs are looked up in a shared AudioFilterCoefficientTable
+  instead of calculated; see setUseCoefficientTable( ).
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class AudioFilter : public IAudioSignalProcessor
+template <typename SampleType>
+class AudioFilter : public IAudioSignalProcessor<SampleType>
 {
 public:
     AudioFilter() {}		/* C-TOR */
@@ -43,9 +50,15 @@ public:
         biquad.setParameters(bqp);
 
         sampleRate = _sampleRate;
+        updateCoefficientTable();
+
         return biquad.reset(_sampleRate);
     }
 
+    /** --- clear the filter state only: the coefficients and the coefficient table are kept, so nothing is
+           designed or (de)allocated and this is safe to call from the audio thread */
+    void flush() { biquad.reset(sampleRate); }
+
     /** return false: this object only processes samples */
     virtual bool canProcessAudioFrame() { return false; }
 
@@ -54,7 +67,15 @@ public:
     \param xn input
     \return the processed sample
     */
-    virtual double processAudioSample(double xn);
+    virtual SampleType processAudioSample(SampleType xn);
+
+    /** process a block of input samples through the filter */
+    /**
+    \param input input samples
+    \param output output samples (may be the same buffer as input)
+    \param numSamples number of samples to process
+    */
+    virtual void processBlock(const SampleType* input, SampleType* output, int numSamples);
 
     /** --- sample rate change necessarily requires recalculation */
     virtual void setSampleRate(double _sampleRate)
@@ -88,15 +109,33 @@ public:
         calculateFilterCoeffs();
     }
 
+    /** --- get the current coefficients, including the c0 and d0 wet/dry coefficients */
+    const double* getCoefficients() { return &coeffArray[0]; }
+
+    /** --- set the coefficients directly, bypassing the filter designs; used to ramp between designs */
+    void setCoefficients(const double* coeffs)
+    {
+        memcpy(&coeffArray[0], &coeffs[0], sizeof(double) * numCoeffs);
+        biquad.setCoefficients(coeffArray);
+    }
+
+    /** --- look the design up in a coefficient table instead of calculating it; takes effect at the next reset( ) */
+    /**
+    NOTE: only kLowShelf, kHiShelf and kCQParaEQ have tables, built for the algorithm (and Q) set at reset( );
+          other designs, and settings outside the table, are calculated as usual
+    \param use true to use the table
+    */
+    void setUseCoefficientTable(bool use) { useCoefficientTable = use; }
+
     /** --- helper for Harma filters (phaser) */
-    double getG_value() { return biquad.getG_value(); }
+    SampleType getG_value() { return biquad.getG_value(); }
 
     /** --- helper for Harma filters (phaser) */
-    double getS_value() { return biquad.getS_value(); }
+    SampleType getS_value() { return biquad.getS_value(); }
 
 protected:
     // --- our calculator
-    Biquad biquad; ///< the biquad object
+    Biquad<SampleType> biquad; ///< the biquad object
 
     // --- array to hold coeffs (we need them too)
     double coeffArray[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 }; ///< our local copy of biquad coeffs
@@ -105,6 +144,15 @@ protected:
     AudioFilterParameters audioFilterParameters; ///< parameters
     double sampleRate = 44100.0; ///< current sample rate
 
+    // --- precomputed designs
+    bool useCoefficientTable = false; ///< look designs up in coefficientTable
+    std::shared_ptr<const AudioFilterCoefficientTable> coefficientTable = nullptr; ///< shared table for the design, if any
+    double coefficientTable_fc = -1.0; ///< fc of coefficientTableIndex
+    double coefficientTableIndex = 0.0; ///< fc grid index of coefficientTable_fc, kept so gain changes skip the log2( )
+
     /** --- function to recalculate coefficients due to a change in filter parameters */
     bool calculateFilterCoeffs();
+
+    /** --- get (or drop) the coefficient table for the current design and sample rate */
+    void updateCoefficientTable();
 };
\ No newline at end of file
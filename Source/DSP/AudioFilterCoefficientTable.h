@@ -0,0 +1,193 @@
+// AudioFilterCoefficientTable.h
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Utilities.h"
+
+// --- the grid of an AudioFilterCoefficientTable: fc in fractions of an octave, gain in dB steps
+const double kCoeffTableMin_fc = 20.0;				///< lowest fc in the tables (Hz)
+const double kCoeffTableMax_fc = 20480.0;			///< highest fc in the tables (Hz), if below 0.45 * fs
+const int kCoeffTablePointsPerOctave = 12;			///< fc grid resolution
+const double kCoeffTableMinBoostCut_dB = -24.0;		///< lowest gain in the tables
+const double kCoeffTableMaxBoostCut_dB = 24.0;		///< highest gain in the tables
+const double kCoeffTableStep_dB = 0.5;				///< gain grid resolution
+
+/**
+\class AudioFilterCoefficientTable
+\ingroup FX-Objects
+\brief
+The AudioFilterCoefficientTable object holds the coefficients of one AudioFilter design (kLowShelf, kHiShelf or
+kCQParaEQ) at one sample rate, precomputed on a grid of fc and gain, and looks coefficients up by bilinear
+interpolation between the four surrounding designs: constant time, no trig or pow calls. At the default grid the
+responses are within about 0.1 dB of the exact designs at 48 kHz (0.01 dB at 96 kHz).
+
+- the grid is log-spaced in fc and linear in dB, so the error is about the same everywhere in the range
+- the interpolated coefficients are a weighted average of stable designs; the stability regions of first
+  order (|b1| < 1) and second order (the b1/b2 triangle) filters are convex, so they are stable too
+- kCQParaEQ tables are designed for one Q; lookups are only valid for that Q
+
+Tables are built with getShared( ), which hands every filter with the same design and sample rate the same
+table, so a session full of reverbs holds one table per shelf type instead of one per filter.
+
+NOTE: building a table runs every design on the grid and allocates; do NOT call getShared( ) from the
+      realtime audio thread.
+*/
+class AudioFilterCoefficientTable
+{
+public:
+    /** the exact design: write the coefficients (numCoeffs of them) of fc and boostCut_dB to coeffs */
+    using DesignFunction = std::function<void(double fc, double boostCut_dB, double* coeffs)>;
+
+    /** design the whole table */
+    /**
+    \param _algorithm filter design, one of the supported( ) ones
+    \param _sampleRate sample rate the designs are for
+    \param _Q filter Q (kCQParaEQ only)
+    \param design the exact design, called once per grid point
+    */
+    AudioFilterCoefficientTable(filterAlgorithm _algorithm, double _sampleRate, double _Q, const DesignFunction& design)
+        : algorithm(_algorithm), sampleRate(_sampleRate), Q(_Q)
+    {
+        const double max_fc = fmin(kCoeffTableMax_fc, 0.45 * sampleRate);
+        numFrequencies = (int)floor(log2(max_fc / kCoeffTableMin_fc) * kCoeffTablePointsPerOctave) + 1;
+        numGains = (int)round((kCoeffTableMaxBoostCut_dB - kCoeffTableMinBoostCut_dB) / kCoeffTableStep_dB) + 1;
+
+        coeffs.resize((size_t)numFrequencies * numGains * numCoeffs);
+
+        for (int i = 0; i < numFrequencies; i++)
+        {
+            double fc = kCoeffTableMin_fc * pow(2.0, (double)i / kCoeffTablePointsPerOctave);
+            for (int j = 0; j < numGains; j++)
+                design(fc, kCoeffTableMinBoostCut_dB + j * kCoeffTableStep_dB, getGridPoint(i, j));
+        }
+    }
+
+    /** true if there are tables for this design */
+    static bool supported(filterAlgorithm _algorithm)
+    {
+        return _algorithm == filterAlgorithm::kLowShelf ||
+               _algorithm == filterAlgorithm::kHiShelf ||
+               _algorithm == filterAlgorithm::kCQParaEQ;
+    }
+
+    /** the table for a design and sample rate, built on first use and shared while anyone holds it */
+    /**
+    \param _algorithm filter design, one of the supported( ) ones
+    \param _sampleRate sample rate the designs are for
+    \param _Q filter Q (kCQParaEQ only)
+    \param design the exact design, only called if the table has to be built
+    \return the shared table
+    */
+    static std::shared_ptr<const AudioFilterCoefficientTable> getShared(filterAlgorithm _algorithm, double _sampleRate,
+                                                                         double _Q, const DesignFunction& design)
+    {
+        static std::mutex lock;
+        static std::vector<std::weak_ptr<const AudioFilterCoefficientTable>> tables;
+
+        std::lock_guard<std::mutex> guard(lock);
+
+        // --- forget the tables nobody holds any more
+        tables.erase(std::remove_if(tables.begin(), tables.end(),
+                                    [](const std::weak_ptr<const AudioFilterCoefficientTable>& table) { return table.expired(); }),
+                     tables.end());
+
+        for (auto& table : tables)
+        {
+            auto sharedTable = table.lock();
+            if (sharedTable && sharedTable->matches(_algorithm, _sampleRate, _Q))
+                return sharedTable;
+        }
+
+        auto sharedTable = std::make_shared<const AudioFilterCoefficientTable>(_algorithm, _sampleRate, _Q, design);
+        tables.push_back(sharedTable);
+        return sharedTable;
+    }
+
+    /** true if this table holds the design of _algorithm at _sampleRate (and _Q, if the design has one) */
+    bool matches(filterAlgorithm _algorithm, double _sampleRate, double _Q) const
+    {
+        return algorithm == _algorithm &&
+               sampleRate == _sampleRate &&
+               (algorithm != filterAlgorithm::kCQParaEQ || Q == _Q);
+    }
+
+    /** the position of fc on the fc grid; the same for every table, so a caller whose fc does not change can
+        keep it and skip the log2( ) with lookupAt( ) */
+    /**
+    \param fc filter fc (Hz)
+    \return the fractional fc grid index
+    */
+    static double getFrequencyIndex(double fc)
+    {
+        return log2(fc / kCoeffTableMin_fc) * kCoeffTablePointsPerOctave;
+    }
+
+    /** look up the coefficients of fc and boostCut_dB */
+    /**
+    \param fc filter fc (Hz)
+    \param boostCut_dB filter gain
+    \param result receives the numCoeffs interpolated coefficients
+    \return false if fc or boostCut_dB is outside the table (result is untouched)
+    */
+    bool lookup(double fc, double boostCut_dB, double* result) const
+    {
+        return lookupAt(getFrequencyIndex(fc), boostCut_dB, result);
+    }
+
+    /** look up the coefficients at an fc grid index from getFrequencyIndex( ) and boostCut_dB */
+    /**
+    \param fcIndex fractional fc grid index
+    \param boostCut_dB filter gain
+    \param result receives the numCoeffs interpolated coefficients
+    \return false if fcIndex or boostCut_dB is outside the table (result is untouched)
+    */
+    bool lookupAt(double fcIndex, double boostCut_dB, double* result) const
+    {
+        double gainIndex = (boostCut_dB - kCoeffTableMinBoostCut_dB) * (1.0 / kCoeffTableStep_dB);
+
+        // --- written so that NaN fails too
+        if (!(fcIndex >= 0.0 && fcIndex <= numFrequencies - 1) ||
+            !(gainIndex >= 0.0 && gainIndex <= numGains - 1))
+            return false;
+
+        // --- the grid cell, and where fc and gain sit inside it
+        int i = (int)fcIndex;
+        if (i > numFrequencies - 2) i = numFrequencies - 2;
+        int j = (int)gainIndex;
+        if (j > numGains - 2) j = numGains - 2;
+
+        double t = fcIndex - i;
+        double u = gainIndex - j;
+
+        const double w00 = (1.0 - t) * (1.0 - u);
+        const double w10 = t * (1.0 - u);
+        const double w01 = (1.0 - t) * u;
+        const double w11 = t * u;
+
+        // --- gain neighbours are next to each other: two pairs of adjacent grid points
+        const double* c0 = getGridPoint(i, j);
+        const double* c1 = getGridPoint(i + 1, j);
+
+        for (int k = 0; k < numCoeffs; k++)
+            result[k] = w00 * c0[k] + w01 * c0[k + numCoeffs] + w10 * c1[k] + w11 * c1[k + numCoeffs];
+
+        return true;
+    }
+
+    /** the memory the coefficients take */
+    size_t getSize_Bytes() const { return coeffs.size() * sizeof(double); }
+
+private:
+    /** the coefficients designed at fc grid point i and gain grid point j */
+    double* getGridPoint(int i, int j) { return &coeffs[((size_t)i * numGains + j) * numCoeffs]; }
+    const double* getGridPoint(int i, int j) const { return &coeffs[((size_t)i * numGains + j) * numCoeffs]; }
+
+    filterAlgorithm algorithm;	///< the design in the table
+    double sampleRate;			///< sample rate of the designs
+    double Q;					///< Q of the designs (kCQParaEQ only)
+
+    int numFrequencies = 0;		///< fc grid points
+    int numGains = 0;			///< gain grid points
+    std::vector<double> coeffs;	///< numCoeffs coefficients per grid point, gain grid points next to each other
+};
\ No newline at end of file
@@ -0,0 +1,766 @@
+// AudioFilterDesigns.cpp
+
+#include "AudioFilterDesigns.h"
+
+// --- the designs, one per filterAlgorithm: each writes a0, a1, a2, b1 and b2 (and c0, d0 if they are not
+//     the pass-through defaults) for fc, Q and boostCut_dB at sampleRate; see book for formulae
+
+// --- impulse invariabt LPF, matches closely with one-pole version,
+//     but diverges at VHF
+static void designImpInvLP1(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    double T = 1.0 / sampleRate;
+    double omega = 2.0 * kPi * fc;
+    double eT = exp(-T * omega);
+
+    coeffs[a0] = 1.0 - eT; // <--- normalized by 1-e^aT
+    coeffs[a1] = 0.0;
+    coeffs[a2] = 0.0;
+    coeffs[b1] = -eT;
+    coeffs[b2] = 0.0;
+}
+
+static void designImpInvLP2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    double alpha = 2.0 * kPi * fc / sampleRate;
+    double p_Re = -alpha / (2.0 * Q);
+    double zeta = 1.0 / (2.0 * Q);
+    double p_Im = alpha * pow((1.0 - (zeta * zeta)), 0.5);
+    double c_Re = 0.0;
+    double c_Im = alpha / (2.0 * pow((1.0 - (zeta * zeta)), 0.5));
+
+    double eP_re = exp(p_Re);
+    coeffs[a0] = c_Re;
+    coeffs[a1] = -2.0 * (c_Re * cos(p_Im) + c_Im * sin(p_Im)) * exp(p_Re);
+    coeffs[a2] = 0.0;
+    coeffs[b1] = -2.0 * eP_re * cos(p_Im);
+    coeffs[b2] = eP_re * eP_re;
+}
+
+// --- kMatchLP2A = TIGHT fit LPF vicanek algo
+static void designMatchLP2A(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // http://vicanek.de/articles/BiquadFits.pdf
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+
+    double q = 1.0 / (2.0 * Q);
+
+    // --- impulse invariant
+    double b_1 = 0.0;
+    double b_2 = exp(-2.0 * q * theta_c);
+    if (q <= 1.0)
+    {
+        b_1 = -2.0 * exp(-q * theta_c) * cos(pow((1.0 - q * q), 0.5) * theta_c);
+    }
+    else
+    {
+        b_1 = -2.0 * exp(-q * theta_c) * cosh(pow((q * q - 1.0), 0.5) * theta_c);
+    }
+
+    // --- TIGHT FIT --- //
+    double B0 = (1.0 + b_1 + b_2) * (1.0 + b_1 + b_2);
+    double B1 = (1.0 - b_1 + b_2) * (1.0 - b_1 + b_2);
+    double B2 = -4.0 * b_2;
+
+    double phi_0 = 1.0 - sin(theta_c / 2.0) * sin(theta_c / 2.0);
+    double phi_1 = sin(theta_c / 2.0) * sin(theta_c / 2.0);
+    double phi_2 = 4.0 * phi_0 * phi_1;
+
+    double R1 = (B0 * phi_0 + B1 * phi_1 + B2 * phi_2) * (Q * Q);
+    double A0 = B0;
+    double A1 = (R1 - A0 * phi_0) / phi_1;
+
+    if (A0 < 0.0)
+        A0 = 0.0;
+    if (A1 < 0.0)
+        A1 = 0.0;
+
+    double a_0 = 0.5 * (pow(A0, 0.5) + pow(A1, 0.5));
+    double a_1 = pow(A0, 0.5) - a_0;
+    double a_2 = 0.0;
+
+    coeffs[a0] = a_0;
+    coeffs[a1] = a_1;
+    coeffs[a2] = a_2;
+    coeffs[b1] = b_1;
+    coeffs[b2] = b_2;
+}
+
+// --- kMatchLP2B = LOOSE fit LPF vicanek algo
+static void designMatchLP2B(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // http://vicanek.de/articles/BiquadFits.pdf
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double q = 1.0 / (2.0 * Q);
+
+    // --- impulse invariant
+    double b_1 = 0.0;
+    double b_2 = exp(-2.0 * q * theta_c);
+    if (q <= 1.0)
+    {
+        b_1 = -2.0 * exp(-q * theta_c) * cos(pow((1.0 - q * q), 0.5) * theta_c);
+    }
+    else
+    {
+        b_1 = -2.0 * exp(-q * theta_c) * cosh(pow((q * q - 1.0), 0.5) * theta_c);
+    }
+
+    // --- LOOSE FIT --- //
+    double f0 = theta_c / kPi; // note f0 = fraction of pi, so that f0 = 1.0 = pi = Nyquist
+
+    double r0 = 1.0 + b_1 + b_2;
+    double denom = (1.0 - f0 * f0) * (1.0 - f0 * f0) + (f0 * f0) / (Q * Q);
+    denom = pow(denom, 0.5);
+    double r1 = ((1.0 - b_1 + b_2) * f0 * f0) / (denom);
+
+    double a_0 = (r0 + r1) / 2.0;
+    double a_1 = r0 - a_0;
+    double a_2 = 0.0;
+
+    coeffs[a0] = a_0;
+    coeffs[a1] = a_1;
+    coeffs[a2] = a_2;
+    coeffs[b1] = b_1;
+    coeffs[b2] = b_2;
+}
+
+// --- kMatchBP2A = TIGHT fit BPF vicanek algo
+static void designMatchBP2A(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // http://vicanek.de/articles/BiquadFits.pdf
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double q = 1.0 / (2.0 * Q);
+
+    // --- impulse invariant
+    double b_1 = 0.0;
+    double b_2 = exp(-2.0 * q * theta_c);
+    if (q <= 1.0)
+    {
+        b_1 = -2.0 * exp(-q * theta_c) * cos(pow((1.0 - q * q), 0.5) * theta_c);
+    }
+    else
+    {
+        b_1 = -2.0 * exp(-q * theta_c) * cosh(pow((q * q - 1.0), 0.5) * theta_c);
+    }
+
+    // --- TIGHT FIT --- //
+    double B0 = (1.0 + b_1 + b_2) * (1.0 + b_1 + b_2);
+    double B1 = (1.0 - b_1 + b_2) * (1.0 - b_1 + b_2);
+    double B2 = -4.0 * b_2;
+
+    double phi_0 = 1.0 - sin(theta_c / 2.0) * sin(theta_c / 2.0);
+    double phi_1 = sin(theta_c / 2.0) * sin(theta_c / 2.0);
+    double phi_2 = 4.0 * phi_0 * phi_1;
+
+    double R1 = B0 * phi_0 + B1 * phi_1 + B2 * phi_2;
+    double R2 = -B0 + B1 + 4.0 * (phi_0 - phi_1) * B2;
+
+    double A2 = (R1 - R2 * phi_1) / (4.0 * phi_1 * phi_1);
+    double A1 = R2 + 4.0 * (phi_1 - phi_0) * A2;
+
+    double a_1 = -0.5 * (pow(A1, 0.5));
+    double a_0 = 0.5 * (pow((A2 + (a_1 * a_1)), 0.5) - a_1);
+    double a_2 = -a_0 - a_1;
+
+    coeffs[a0] = a_0;
+    coeffs[a1] = a_1;
+    coeffs[a2] = a_2;
+    coeffs[b1] = b_1;
+    coeffs[b2] = b_2;
+}
+
+// --- kMatchBP2B = LOOSE fit BPF vicanek algo
+static void designMatchBP2B(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // http://vicanek.de/articles/BiquadFits.pdf
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double q = 1.0 / (2.0 * Q);
+
+    // --- impulse invariant
+    double b_1 = 0.0;
+    double b_2 = exp(-2.0 * q * theta_c);
+    if (q <= 1.0)
+    {
+        b_1 = -2.0 * exp(-q * theta_c) * cos(pow((1.0 - q * q), 0.5) * theta_c);
+    }
+    else
+    {
+        b_1 = -2.0 * exp(-q * theta_c) * cosh(pow((q * q - 1.0), 0.5) * theta_c);
+    }
+
+    // --- LOOSE FIT --- //
+    double f0 = theta_c / kPi; // note f0 = fraction of pi, so that f0 = 1.0 = pi = Nyquist
+
+    double r0 = (1.0 + b_1 + b_2) / (kPi * f0 * Q);
+    double denom = (1.0 - f0 * f0) * (1.0 - f0 * f0) + (f0 * f0) / (Q * Q);
+    denom = pow(denom, 0.5);
+
+    double r1 = ((1.0 - b_1 + b_2) * (f0 / Q)) / (denom);
+
+    double a_1 = -r1 / 2.0;
+    double a_0 = (r0 - a_1) / 2.0;
+    double a_2 = -a_0 - a_1;
+
+    coeffs[a0] = a_0;
+    coeffs[a1] = a_1;
+    coeffs[a2] = a_2;
+    coeffs[b1] = b_1;
+    coeffs[b2] = b_2;
+}
+
+static void designLPF1P(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double gamma = 2.0 - cos(theta_c);
+
+    double filter_b1 = pow((gamma * gamma - 1.0), 0.5) - gamma;
+    double filter_a0 = 1.0 + filter_b1;
+
+    // --- update coeffs
+    coeffs[a0] = filter_a0;
+    coeffs[a1] = 0.0;
+    coeffs[a2] = 0.0;
+    coeffs[b1] = filter_b1;
+    coeffs[b2] = 0.0;
+}
+
+static void designLPF1(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double gamma = cos(theta_c) / (1.0 + sin(theta_c));
+
+    // --- update coeffs
+    coeffs[a0] = (1.0 - gamma) / 2.0;
+    coeffs[a1] = (1.0 - gamma) / 2.0;
+    coeffs[a2] = 0.0;
+    coeffs[b1] = -gamma;
+    coeffs[b2] = 0.0;
+}
+
+static void designHPF1(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double gamma = cos(theta_c) / (1.0 + sin(theta_c));
+
+    // --- update coeffs
+    coeffs[a0] = (1.0 + gamma) / 2.0;
+    coeffs[a1] = -(1.0 + gamma) / 2.0;
+    coeffs[a2] = 0.0;
+    coeffs[b1] = -gamma;
+    coeffs[b2] = 0.0;
+}
+
+static void designLPF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double d = 1.0 / Q;
+    double betaNumerator = 1.0 - ((d / 2.0) * (sin(theta_c)));
+    double betaDenominator = 1.0 + ((d / 2.0) * (sin(theta_c)));
+
+    double beta = 0.5 * (betaNumerator / betaDenominator);
+    double gamma = (0.5 + beta) * (cos(theta_c));
+    double alpha = (0.5 + beta - gamma) / 2.0;
+
+    // --- update coeffs
+    coeffs[a0] = alpha;
+    coeffs[a1] = 2.0 * alpha;
+    coeffs[a2] = alpha;
+    coeffs[b1] = -2.0 * gamma;
+    coeffs[b2] = 2.0 * beta;
+
+    //	double mag = getMagResponse(theta_c, coeffs[a0], coeffs[a1], coeffs[a2], coeffs[b1], coeffs[b2]);
+}
+
+static void designHPF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double d = 1.0 / Q;
+
+    double betaNumerator = 1.0 - ((d / 2.0) * (sin(theta_c)));
+    double betaDenominator = 1.0 + ((d / 2.0) * (sin(theta_c)));
+
+    double beta = 0.5 * (betaNumerator / betaDenominator);
+    double gamma = (0.5 + beta) * (cos(theta_c));
+    double alpha = (0.5 + beta + gamma) / 2.0;
+
+    // --- update coeffs
+    coeffs[a0] = alpha;
+    coeffs[a1] = -2.0 * alpha;
+    coeffs[a2] = alpha;
+    coeffs[b1] = -2.0 * gamma;
+    coeffs[b2] = 2.0 * beta;
+}
+
+static void designBPF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double K = tan(kPi * fc / sampleRate);
+    double delta = K * K * Q + K + Q;
+
+    // --- update coeffs
+    coeffs[a0] = K / delta;;
+    coeffs[a1] = 0.0;
+    coeffs[a2] = -K / delta;
+    coeffs[b1] = 2.0 * Q * (K * K - 1) / delta;
+    coeffs[b2] = (K * K * Q - K + Q) / delta;
+}
+
+static void designBSF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double K = tan(kPi * fc / sampleRate);
+    double delta = K * K * Q + K + Q;
+
+    // --- update coeffs
+    coeffs[a0] = Q * (1 + K * K) / delta;
+    coeffs[a1] = 2.0 * Q * (K * K - 1) / delta;
+    coeffs[a2] = Q * (1 + K * K) / delta;
+    coeffs[b1] = 2.0 * Q * (K * K - 1) / delta;
+    coeffs[b2] = (K * K * Q - K + Q) / delta;
+}
+
+static void designButterLPF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = kPi * fc / sampleRate;
+    double C = 1.0 / tan(theta_c);
+
+    // --- update coeffs
+    coeffs[a0] = 1.0 / (1.0 + kSqrtTwo * C + C * C);
+    coeffs[a1] = 2.0 * coeffs[a0];
+    coeffs[a2] = coeffs[a0];
+    coeffs[b1] = 2.0 * coeffs[a0] * (1.0 - C * C);
+    coeffs[b2] = coeffs[a0] * (1.0 - kSqrtTwo * C + C * C);
+}
+
+static void designButterHPF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = kPi * fc / sampleRate;
+    double C = tan(theta_c);
+
+    // --- update coeffs
+    coeffs[a0] = 1.0 / (1.0 + kSqrtTwo * C + C * C);
+    coeffs[a1] = -2.0 * coeffs[a0];
+    coeffs[a2] = coeffs[a0];
+    coeffs[b1] = 2.0 * coeffs[a0] * (C * C - 1.0);
+    coeffs[b2] = coeffs[a0] * (1.0 - kSqrtTwo * C + C * C);
+}
+
+static void designButterBPF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double BW = fc / Q;
+    double delta_c = kPi * BW / sampleRate;
+    if (delta_c >= 0.95 * kPi / 2.0) delta_c = 0.95 * kPi / 2.0;
+
+    double C = 1.0 / tan(delta_c);
+    double D = 2.0 * cos(theta_c);
+
+    // --- update coeffs
+    coeffs[a0] = 1.0 / (1.0 + C);
+    coeffs[a1] = 0.0;
+    coeffs[a2] = -coeffs[a0];
+    coeffs[b1] = -coeffs[a0] * (C * D);
+    coeffs[b2] = coeffs[a0] * (C - 1.0);
+}
+
+static void designButterBSF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double BW = fc / Q;
+    double delta_c = kPi * BW / sampleRate;
+    if (delta_c >= 0.95 * kPi / 2.0) delta_c = 0.95 * kPi / 2.0;
+
+    double C = tan(delta_c);
+    double D = 2.0 * cos(theta_c);
+
+    // --- update coeffs
+    coeffs[a0] = 1.0 / (1.0 + C);
+    coeffs[a1] = -coeffs[a0] * D;
+    coeffs[a2] = coeffs[a0];
+    coeffs[b1] = -coeffs[a0] * D;
+    coeffs[b2] = coeffs[a0] * (1.0 - C);
+}
+
+// --- kMMALPF2 and kMMALPF2B differ only in the gain reduction
+static void calculateMMALPF2(double fc, double Q, double sampleRate, double* coeffs, bool gainReduction)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double resonance_dB = 0;
+
+    if (Q > 0.707)
+    {
+        double peak = Q * Q / pow(Q * Q - 0.25, 0.5);
+        resonance_dB = 20.0 * log10(peak);
+    }
+
+    // --- intermediate vars
+    double resonance = (cos(theta_c) + (sin(theta_c) * sqrt(pow(10.0, (resonance_dB / 10.0)) - 1))) / ((pow(10.0, (resonance_dB / 20.0)) * sin(theta_c)) + 1);
+    double g = pow(10.0, (-resonance_dB / 40.0));
+
+    // --- kMMALPF2B disables the GR with increase in Q
+    if (!gainReduction)
+        g = 1.0;
+
+    double filter_b1 = (-2.0) * resonance * cos(theta_c);
+    double filter_b2 = resonance * resonance;
+    double filter_a0 = g * (1 + filter_b1 + filter_b2);
+
+    // --- update coeffs
+    coeffs[a0] = filter_a0;
+    coeffs[a1] = 0.0;
+    coeffs[a2] = 0.0;
+    coeffs[b1] = filter_b1;
+    coeffs[b2] = filter_b2;
+}
+
+static void designMMALPF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    calculateMMALPF2(fc, Q, sampleRate, coeffs, true);
+}
+
+static void designMMALPF2B(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    calculateMMALPF2(fc, Q, sampleRate, coeffs, false);
+}
+
+static void designLowShelf(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double mu = pow(10.0, boostCut_dB / 20.0);
+
+    double beta = 4.0 / (1.0 + mu);
+    double delta = beta * tan(theta_c / 2.0);
+    double gamma = (1.0 - delta) / (1.0 + delta);
+
+    // --- update coeffs
+    coeffs[a0] = (1.0 - gamma) / 2.0;
+    coeffs[a1] = (1.0 - gamma) / 2.0;
+    coeffs[a2] = 0.0;
+    coeffs[b1] = -gamma;
+    coeffs[b2] = 0.0;
+
+    coeffs[c0] = mu - 1.0;
+    coeffs[d0] = 1.0;
+}
+
+static void designHiShelf(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double mu = pow(10.0, boostCut_dB / 20.0);
+
+    double beta = (1.0 + mu) / 4.0;
+    double delta = beta * tan(theta_c / 2.0);
+    double gamma = (1.0 - delta) / (1.0 + delta);
+
+    coeffs[a0] = (1.0 + gamma) / 2.0;
+    coeffs[a1] = -coeffs[a0];
+    coeffs[a2] = 0.0;
+    coeffs[b1] = -gamma;
+    coeffs[b2] = 0.0;
+
+    coeffs[c0] = mu - 1.0;
+    coeffs[d0] = 1.0;
+}
+
+static void designCQParaEQ(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double K = tan(kPi * fc / sampleRate);
+    double Vo = pow(10.0, boostCut_dB / 20.0);
+    bool bBoost = boostCut_dB >= 0 ? true : false;
+
+    double d0 = 1.0 + (1.0 / Q) * K + K * K;
+    double e0 = 1.0 + (1.0 / (Vo * Q)) * K + K * K;
+    double alpha = 1.0 + (Vo / Q) * K + K * K;
+    double beta = 2.0 * (K * K - 1.0);
+    double gamma = 1.0 - (Vo / Q) * K + K * K;
+    double delta = 1.0 - (1.0 / Q) * K + K * K;
+    double eta = 1.0 - (1.0 / (Vo * Q)) * K + K * K;
+
+    // --- update coeffs
+    coeffs[a0] = bBoost ? alpha / d0 : d0 / e0;
+    coeffs[a1] = bBoost ? beta / d0 : beta / e0;
+    coeffs[a2] = bBoost ? gamma / d0 : delta / e0;
+    coeffs[b1] = bBoost ? beta / d0 : beta / e0;
+    coeffs[b2] = bBoost ? delta / d0 : eta / e0;
+}
+
+static void designNCQParaEQ(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double mu = pow(10.0, boostCut_dB / 20.0);
+
+    // --- clamp to 0.95 pi/2 (you can experiment with this)
+    double tanArg = theta_c / (2.0 * Q);
+    if (tanArg >= 0.95 * kPi / 2.0) tanArg = 0.95 * kPi / 2.0;
+
+    // --- intermediate variables (you can condense this if you wish)
+    double zeta = 4.0 / (1.0 + mu);
+    double betaNumerator = 1.0 - zeta * tan(tanArg);
+    double betaDenominator = 1.0 + zeta * tan(tanArg);
+
+    double beta = 0.5 * (betaNumerator / betaDenominator);
+    double gamma = (0.5 + beta) * (cos(theta_c));
+    double alpha = (0.5 - beta);
+
+    // --- update coeffs
+    coeffs[a0] = alpha;
+    coeffs[a1] = 0.0;
+    coeffs[a2] = -alpha;
+    coeffs[b1] = -2.0 * gamma;
+    coeffs[b2] = 2.0 * beta;
+
+    coeffs[c0] = mu - 1.0;
+    coeffs[d0] = 1.0;
+}
+
+static void designLWRLPF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double omega_c = kPi * fc;
+    double theta_c = kPi * fc / sampleRate;
+
+    double k = omega_c / tan(theta_c);
+    double denominator = k * k + omega_c * omega_c + 2.0 * k * omega_c;
+    double b1_Num = -2.0 * k * k + 2.0 * omega_c * omega_c;
+    double b2_Num = -2.0 * k * omega_c + k * k + omega_c * omega_c;
+
+    // --- update coeffs
+    coeffs[a0] = omega_c * omega_c / denominator;
+    coeffs[a1] = 2.0 * omega_c * omega_c / denominator;
+    coeffs[a2] = coeffs[a0];
+    coeffs[b1] = b1_Num / denominator;
+    coeffs[b2] = b2_Num / denominator;
+}
+
+static void designLWRHPF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double omega_c = kPi * fc;
+    double theta_c = kPi * fc / sampleRate;
+
+    double k = omega_c / tan(theta_c);
+    double denominator = k * k + omega_c * omega_c + 2.0 * k * omega_c;
+    double b1_Num = -2.0 * k * k + 2.0 * omega_c * omega_c;
+    double b2_Num = -2.0 * k * omega_c + k * k + omega_c * omega_c;
+
+    // --- update coeffs
+    coeffs[a0] = k * k / denominator;
+    coeffs[a1] = -2.0 * k * k / denominator;
+    coeffs[a2] = coeffs[a0];
+    coeffs[b1] = b1_Num / denominator;
+    coeffs[b2] = b2_Num / denominator;
+}
+
+static void designAPF1(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double alphaNumerator = tan((kPi * fc) / sampleRate) - 1.0;
+    double alphaDenominator = tan((kPi * fc) / sampleRate) + 1.0;
+    double alpha = alphaNumerator / alphaDenominator;
+
+    // --- update coeffs
+    coeffs[a0] = alpha;
+    coeffs[a1] = 1.0;
+    coeffs[a2] = 0.0;
+    coeffs[b1] = alpha;
+    coeffs[b2] = 0.0;
+}
+
+static void designAPF2(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double BW = fc / Q;
+    double argTan = kPi * BW / sampleRate;
+    if (argTan >= 0.95 * kPi / 2.0) argTan = 0.95 * kPi / 2.0;
+
+    double alphaNumerator = tan(argTan) - 1.0;
+    double alphaDenominator = tan(argTan) + 1.0;
+    double alpha = alphaNumerator / alphaDenominator;
+    double beta = -cos(theta_c);
+
+    // --- update coeffs
+    coeffs[a0] = -alpha;
+    coeffs[a1] = beta * (1.0 - alpha);
+    coeffs[a2] = 1.0;
+    coeffs[b1] = beta * (1.0 - alpha);
+    coeffs[b2] = -alpha;
+}
+
+static void designResonA(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double BW = fc / Q;
+    double filter_b2 = exp(-2.0 * kPi * (BW / sampleRate));
+    double filter_b1 = ((-4.0 * filter_b2) / (1.0 + filter_b2)) * cos(theta_c);
+    double filter_a0 = (1.0 - filter_b2) * pow((1.0 - (filter_b1 * filter_b1) / (4.0 * filter_b2)), 0.5);
+
+    // --- update coeffs
+    coeffs[a0] = filter_a0;
+    coeffs[a1] = 0.0;
+    coeffs[a2] = 0.0;
+    coeffs[b1] = filter_b1;
+    coeffs[b2] = filter_b2;
+}
+
+static void designResonB(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs)
+{
+    // --- see book for formulae
+    double theta_c = 2.0 * kPi * fc / sampleRate;
+    double BW = fc / Q;
+    double filter_b2 = exp(-2.0 * kPi * (BW / sampleRate));
+    double filter_b1 = ((-4.0 * filter_b2) / (1.0 + filter_b2)) * cos(theta_c);
+    double filter_a0 = 1.0 - pow(filter_b2, 0.5); // (1.0 - filter_b2)*pow((1.0 - (filter_b1*filter_b1) / (4.0 * filter_b2)), 0.5);
+
+    // --- update coeffs
+    coeffs[a0] = filter_a0;
+    coeffs[a1] = 0.0;
+    coeffs[a2] = -filter_a0;
+    coeffs[b1] = filter_b1;
+    coeffs[b2] = filter_b2;
+}
+
+// --- the defaults every design starts from
+static inline void setPassThroughCoeffs(double* coeffs)
+{
+    memset(&coeffs[0], 0, sizeof(double) * numCoeffs);
+
+    coeffs[a0] = 1.0;
+    coeffs[c0] = 1.0;
+    coeffs[d0] = 0.0;
+}
+
+// --- a run of filters with the same design: one loop with the design inlined into it
+template <FilterDesignFunction design>
+static void designEach(const AudioFilterParameters* params, int numFilters, double sampleRate, double* coeffs)
+{
+    for (int i = 0; i < numFilters; i++, coeffs += numCoeffs)
+    {
+        // --- don't allow 0 or (-) values for Q, like AudioFilter::setParameters( )
+        double Q = params[i].Q > 0.0 ? params[i].Q : 0.707;
+
+        setPassThroughCoeffs(coeffs);
+        design(params[i].fc, Q, params[i].boostCut_dB, sampleRate, coeffs);
+    }
+}
+
+using FilterBatchDesignFunction = void (*)(const AudioFilterParameters* params, int numFilters, double sampleRate, double* coeffs);
+
+struct FilterDesign
+{
+    filterAlgorithm algorithm;					///< the design's algorithm, to check the table order
+    FilterDesignFunction design;				///< one filter
+    FilterBatchDesignFunction designBatch;		///< a run of filters
+};
+
+// --- indexed by filterAlgorithm
+static constexpr FilterDesign kFilterDesigns[] =
+{
+    { filterAlgorithm::kLPF1P,      designLPF1P,      designEach<designLPF1P> },
+    { filterAlgorithm::kLPF1,       designLPF1,       designEach<designLPF1> },
+    { filterAlgorithm::kHPF1,       designHPF1,       designEach<designHPF1> },
+    { filterAlgorithm::kLPF2,       designLPF2,       designEach<designLPF2> },
+    { filterAlgorithm::kHPF2,       designHPF2,       designEach<designHPF2> },
+    { filterAlgorithm::kBPF2,       designBPF2,       designEach<designBPF2> },
+    { filterAlgorithm::kBSF2,       designBSF2,       designEach<designBSF2> },
+    { filterAlgorithm::kButterLPF2, designButterLPF2, designEach<designButterLPF2> },
+    { filterAlgorithm::kButterHPF2, designButterHPF2, designEach<designButterHPF2> },
+    { filterAlgorithm::kButterBPF2, designButterBPF2, designEach<designButterBPF2> },
+    { filterAlgorithm::kButterBSF2, designButterBSF2, designEach<designButterBSF2> },
+    { filterAlgorithm::kMMALPF2,    designMMALPF2,    designEach<designMMALPF2> },
+    { filterAlgorithm::kMMALPF2B,   designMMALPF2B,   designEach<designMMALPF2B> },
+    { filterAlgorithm::kLowShelf,   designLowShelf,   designEach<designLowShelf> },
+    { filterAlgorithm::kHiShelf,    designHiShelf,    designEach<designHiShelf> },
+    { filterAlgorithm::kNCQParaEQ,  designNCQParaEQ,  designEach<designNCQParaEQ> },
+    { filterAlgorithm::kCQParaEQ,   designCQParaEQ,   designEach<designCQParaEQ> },
+    { filterAlgorithm::kLWRLPF2,    designLWRLPF2,    designEach<designLWRLPF2> },
+    { filterAlgorithm::kLWRHPF2,    designLWRHPF2,    designEach<designLWRHPF2> },
+    { filterAlgorithm::kAPF1,       designAPF1,       designEach<designAPF1> },
+    { filterAlgorithm::kAPF2,       designAPF2,       designEach<designAPF2> },
+    { filterAlgorithm::kResonA,     designResonA,     designEach<designResonA> },
+    { filterAlgorithm::kResonB,     designResonB,     designEach<designResonB> },
+    { filterAlgorithm::kMatchLP2A,  designMatchLP2A,  designEach<designMatchLP2A> },
+    { filterAlgorithm::kMatchLP2B,  designMatchLP2B,  designEach<designMatchLP2B> },
+    { filterAlgorithm::kMatchBP2A,  designMatchBP2A,  designEach<designMatchBP2A> },
+    { filterAlgorithm::kMatchBP2B,  designMatchBP2B,  designEach<designMatchBP2B> },
+    { filterAlgorithm::kImpInvLP1,  designImpInvLP1,  designEach<designImpInvLP1> },
+    { filterAlgorithm::kImpInvLP2,  designImpInvLP2,  designEach<designImpInvLP2> },
+};
+
+static constexpr bool filterDesignsAreInEnumOrder()
+{
+    for (int i = 0; i < kNumFilterAlgorithms; i++)
+    {
+        if ((int)kFilterDesigns[i].algorithm != i)
+            return false;
+    }
+    return true;
+}
+
+static_assert(sizeof(kFilterDesigns) / sizeof(kFilterDesigns[0]) == kNumFilterAlgorithms, "kFilterDesigns needs one entry per filterAlgorithm");
+static_assert(filterDesignsAreInEnumOrder(), "kFilterDesigns must be in filterAlgorithm order");
+
+static inline bool isValidFilterAlgorithm(filterAlgorithm algorithm)
+{
+    return (int)algorithm >= 0 && (int)algorithm < kNumFilterAlgorithms;
+}
+
+FilterDesignFunction getFilterDesign(filterAlgorithm algorithm)
+{
+    return isValidFilterAlgorithm(algorithm) ? kFilterDesigns[(int)algorithm].design : nullptr;
+}
+
+bool designFilter(const AudioFilterParameters& params, double sampleRate, double* coeffs)
+{
+    setPassThroughCoeffs(coeffs);
+
+    if (!isValidFilterAlgorithm(params.algorithm))
+        return false;
+
+    kFilterDesigns[(int)params.algorithm].design(params.fc, params.Q, params.boostCut_dB, sampleRate, coeffs);
+    return true;
+}
+
+bool designFilters(const AudioFilterParameters* params, int numFilters, double sampleRate, double* coeffs)
+{
+    bool designedAll = true;
+
+    // --- hand each run of filters with the same algorithm to that design's loop
+    int start = 0;
+    while (start < numFilters)
+    {
+        filterAlgorithm algorithm = params[start].algorithm;
+
+        int end = start + 1;
+        while (end < numFilters && params[end].algorithm == algorithm)
+            end++;
+
+        if (isValidFilterAlgorithm(algorithm))
+            kFilterDesigns[(int)algorithm].designBatch(params + start, end - start, sampleRate, coeffs + start * numCoeffs);
+        else
+        {
+            for (int i = start; i < end; i++)
+                setPassThroughCoeffs(coeffs + i * numCoeffs);
+
+            designedAll = false;
+        }
+
+        start = end;
+    }
+
+    return designedAll;
+}
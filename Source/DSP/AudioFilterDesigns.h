@@ -0,0 +1,60 @@
+// AudioFilterDesigns.h
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Utilities.h"
+#include "AudioFilterParameters.h"
+
+// --- number of filterAlgorithm values; keep in step with the enum (kFilterDesigns checks it at compile time)
+const int kNumFilterAlgorithms = (int)filterAlgorithm::kImpInvLP2 + 1;
+
+/**
+@FilterDesignFunction
+\ingroup FX-Functions
+
+@brief the coefficient design of one filterAlgorithm; writes a0, a1, a2, b1 and b2 (and c0 and d0 where
+the design mixes in the dry signal) to coeffs, which must already hold the pass-through defaults
+*/
+using FilterDesignFunction = void (*)(double fc, double Q, double boostCut_dB, double sampleRate, double* coeffs);
+
+/**
+@getFilterDesign
+\ingroup FX-Functions
+
+@brief look up the design of a filterAlgorithm in the design table; one array index, no if/else chain
+
+\param algorithm - the filter algorithm
+\return the design function, or nullptr if algorithm is not a filterAlgorithm
+*/
+FilterDesignFunction getFilterDesign(filterAlgorithm algorithm);
+
+/**
+@designFilter
+\ingroup FX-Functions
+
+@brief design the coefficients of one filter, as AudioFilter does
+
+\param params - the filter algorithm, fc, Q and gain
+\param sampleRate - the sample rate
+\param coeffs - receives numCoeffs coefficients (a0, a1, a2, b1, b2, c0, d0)
+\return false if params.algorithm is not a filterAlgorithm (coeffs are then pass-through)
+*/
+bool designFilter(const AudioFilterParameters& params, double sampleRate, double* coeffs);
+
+/**
+@designFilters
+\ingroup FX-Functions
+
+@brief design the coefficients of many filters in one pass, e.g. all the bands of a multiband EQ or all the
+branches of a reverb; each run of filters with the same algorithm is designed in one loop with its design
+inlined, so order the filters by algorithm to get the longest runs. Q <= 0 is taken as 0.707, like
+AudioFilter::setParameters( ).
+
+\param params - numFilters filter settings
+\param numFilters - the number of filters
+\param sampleRate - the sample rate of all the filters
+\param coeffs - receives numCoeffs coefficients per filter, one filter after the other
+\return false if any algorithm is not a filterAlgorithm (those filters are then pass-through)
+*/
+bool designFilters(const AudioFilterParameters* params, int numFilters, double sampleRate, double* coeffs);
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "Biquad.h"
 
 /**
-\brief process one sample through the biquad
+\brief the four biquad structures, one per specialization
 
 - RULES:\n
 1) do all math required to form the output y(n), reading registers as required - do NOT write registers \n
@@ -11,18 +11,20 @@
 3) lastly, update the states of the z^-1 registers in the state array just before returning\n
 
 - NOTES:\n
+the coefficients and states are passed in so the block loops can run on local copies that stay in registers\n
 the storageComponent or "S" value is used for Zavalishin's VA filters and is only
 available on two of the forms: direct and transposed canonical\n
-
-\param xn the input sample x(n)
-\returns the biquad processed output y(n)
 */
-double Biquad::processAudioSample(double xn)
+template <typename SampleType, biquadAlgorithm Form>
+struct BiquadStructure;
+
+template <typename SampleType>
+struct BiquadStructure<SampleType, biquadAlgorithm::kDirect>
 {
-    if (parameters.biquadCalcType == biquadAlgorithm::kDirect)
+    static inline SampleType process(const SampleType* coeffArray, SampleType* stateArray, SampleType xn)
     {
         // --- 1)  form output y(n) = a0*x(n) + a1*x(n-1) + a2*x(n-2) - b1*y(n-1) - b2*y(n-2)
-        double yn = coeffArray[a0] * xn +
+        SampleType yn = coeffArray[a0] * xn +
             coeffArray[a1] * stateArray[x_z1] +
             coeffArray[a2] * stateArray[x_z2] -
             coeffArray[b1] * stateArray[y_z1] -
@@ -41,15 +43,20 @@ double Biquad::processAudioSample(double xn)
         // --- return value
         return yn;
     }
-    else if (parameters.biquadCalcType == biquadAlgorithm::kCanonical)
+};
+
+template <typename SampleType>
+struct BiquadStructure<SampleType, biquadAlgorithm::kCanonical>
+{
+    static inline SampleType process(const SampleType* coeffArray, SampleType* stateArray, SampleType xn)
     {
         // --- 1)  form output y(n) = a0*w(n) + m_f_a1*stateArray[x_z1] + m_f_a2*stateArray[x_z2][x_z2];
         //
         // --- w(n) = x(n) - b1*stateArray[x_z1] - b2*stateArray[x_z2]
-        double wn = xn - coeffArray[b1] * stateArray[x_z1] - coeffArray[b2] * stateArray[x_z2];
+        SampleType wn = xn - coeffArray[b1] * stateArray[x_z1] - coeffArray[b2] * stateArray[x_z2];
 
         // --- y(n):
-        double yn = coeffArray[a0] * wn + coeffArray[a1] * stateArray[x_z1] + coeffArray[a2] * stateArray[x_z2];
+        SampleType yn = coeffArray[a0] * wn + coeffArray[a1] * stateArray[x_z1] + coeffArray[a2] * stateArray[x_z2];
 
         // --- 2) underflow check
         checkFloatUnderflow(yn);
@@ -61,15 +68,20 @@ double Biquad::processAudioSample(double xn)
         // --- return value
         return yn;
     }
-    else if (parameters.biquadCalcType == biquadAlgorithm::kTransposeDirect)
+};
+
+template <typename SampleType>
+struct BiquadStructure<SampleType, biquadAlgorithm::kTransposeDirect>
+{
+    static inline SampleType process(const SampleType* coeffArray, SampleType* stateArray, SampleType xn)
     {
         // --- 1)  form output y(n) = a0*w(n) + stateArray[x_z1]
         //
         // --- w(n) = x(n) + stateArray[y_z1]
-        double wn = xn + stateArray[y_z1];
+        SampleType wn = xn + stateArray[y_z1];
 
         // --- y(n) = a0*w(n) + stateArray[x_z1]
-        double yn = coeffArray[a0] * wn + stateArray[x_z1];
+        SampleType yn = coeffArray[a0] * wn + stateArray[x_z1];
 
         // --- 2) underflow check
         checkFloatUnderflow(yn);
@@ -84,10 +96,15 @@ double Biquad::processAudioSample(double xn)
         // --- return value
         return yn;
     }
-    else if (parameters.biquadCalcType == biquadAlgorithm::kTransposeCanonical)
+};
+
+template <typename SampleType>
+struct BiquadStructure<SampleType, biquadAlgorithm::kTransposeCanonical>
+{
+    static inline SampleType process(const SampleType* coeffArray, SampleType* stateArray, SampleType xn)
     {
         // --- 1)  form output y(n) = a0*x(n) + stateArray[x_z1]
-        double yn = coeffArray[a0] * xn + stateArray[x_z1];
+        SampleType yn = coeffArray[a0] * xn + stateArray[x_z1];
 
         // --- 2) underflow check
         checkFloatUnderflow(yn);
@@ -99,5 +116,124 @@ double Biquad::processAudioSample(double xn)
         // --- return value
         return yn;
     }
+};
+
+/**
+\brief process one sample through the biquad
+
+- NOTES:\n
+one sample at a time there is nothing to amortize the structure selection over, so this switches per call;
+use processBlock( ) wherever there is a block\n
+
+\param xn the input sample x(n)
+\returns the biquad processed output y(n)
+*/
+template <typename SampleType>
+SampleType Biquad<SampleType>::processAudioSample(SampleType xn)
+{
+    switch (parameters.biquadCalcType)
+    {
+    case biquadAlgorithm::kDirect:
+        return BiquadStructure<SampleType, biquadAlgorithm::kDirect>::process(coeffArray, stateArray, xn);
+    case biquadAlgorithm::kCanonical:
+        return BiquadStructure<SampleType, biquadAlgorithm::kCanonical>::process(coeffArray, stateArray, xn);
+    case biquadAlgorithm::kTransposeDirect:
+        return BiquadStructure<SampleType, biquadAlgorithm::kTransposeDirect>::process(coeffArray, stateArray, xn);
+    case biquadAlgorithm::kTransposeCanonical:
+        return BiquadStructure<SampleType, biquadAlgorithm::kTransposeCanonical>::process(coeffArray, stateArray, xn);
+    }
     return xn; // didn't process anything :(
-}
\ No newline at end of file
+}
+
+/**
+\brief process a block of samples through the biquad
+
+- NOTES:\n
+runs the block loop of the current structure, chosen in setParameters( )\n
+
+\param input the input samples x(n)
+\param output the biquad processed outputs y(n); may be the same buffer as input
+\param numSamples the number of samples to process
+*/
+template <typename SampleType>
+void Biquad<SampleType>::processBlock(const SampleType* input, SampleType* output, int numSamples)
+{
+    (this->*blockProcessor)(input, output, numSamples, (SampleType)1.0, (SampleType)0.0);
+}
+
+/**
+\brief process a block of samples through the biquad and mix in the dry input
+
+- NOTES:\n
+output = dry * x(n) + wet * y(n), as AudioFilter combines its c0 and d0 coefficients\n
+
+\param input the input samples x(n)
+\param output the mixed outputs; may be the same buffer as input
+\param numSamples the number of samples to process
+\param wet the gain of the biquad output y(n)
+\param dry the gain of the input x(n)
+*/
+template <typename SampleType>
+void Biquad<SampleType>::processBlock(const SampleType* input, SampleType* output, int numSamples, SampleType wet, SampleType dry)
+{
+    (this->*mixedBlockProcessor)(input, output, numSamples, wet, dry);
+}
+
+/**
+\brief the block loop of one structure
+
+- NOTES:\n
+the coefficients and states are copied to locals for the block and the states stored back at the end, so
+the loop does not reload them from the arrays every sample\n
+*/
+template <typename SampleType>
+template <biquadAlgorithm Form, bool MixDryWet>
+void Biquad<SampleType>::processFormBlock(const SampleType* input, SampleType* output, int numSamples, SampleType wet, SampleType dry)
+{
+    SampleType coeffs[numCoeffs];
+    SampleType states[numStates];
+    memcpy(&coeffs[0], &coeffArray[0], sizeof(coeffs));
+    memcpy(&states[0], &stateArray[0], sizeof(states));
+
+    for (int i = 0; i < numSamples; i++)
+    {
+        SampleType xn = input[i];
+        SampleType yn = BiquadStructure<SampleType, Form>::process(coeffs, states, xn);
+
+        if (MixDryWet)
+            output[i] = dry * xn + wet * yn;
+        else
+            output[i] = yn;
+    }
+
+    memcpy(&stateArray[0], &states[0], sizeof(states));
+}
+
+/** point the block processors at the loops of the current structure */
+template <typename SampleType>
+void Biquad<SampleType>::selectBlockProcessors()
+{
+    switch (parameters.biquadCalcType)
+    {
+    case biquadAlgorithm::kDirect:
+        blockProcessor = &Biquad::processFormBlock<biquadAlgorithm::kDirect, false>;
+        mixedBlockProcessor = &Biquad::processFormBlock<biquadAlgorithm::kDirect, true>;
+        break;
+    case biquadAlgorithm::kCanonical:
+        blockProcessor = &Biquad::processFormBlock<biquadAlgorithm::kCanonical, false>;
+        mixedBlockProcessor = &Biquad::processFormBlock<biquadAlgorithm::kCanonical, true>;
+        break;
+    case biquadAlgorithm::kTransposeDirect:
+        blockProcessor = &Biquad::processFormBlock<biquadAlgorithm::kTransposeDirect, false>;
+        mixedBlockProcessor = &Biquad::processFormBlock<biquadAlgorithm::kTransposeDirect, true>;
+        break;
+    case biquadAlgorithm::kTransposeCanonical:
+        blockProcessor = &Biquad::processFormBlock<biquadAlgorithm::kTransposeCanonical, false>;
+        mixedBlockProcessor = &Biquad::processFormBlock<biquadAlgorithm::kTransposeCanonical, true>;
+        break;
+    }
+}
+
+// --- the sample types the DSP objects are built for
+template class Biquad<float>;
+template class Biquad<double>;
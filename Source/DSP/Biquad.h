@@ -16,16 +16,21 @@ Audio I/O:
 
 Control I/F:
 - Use BiquadParameters structure to get/set object params.
+- Template parameter SampleType is the type (float or double) of the audio, coefficients and states;
+  coefficients are designed in double and converted in setCoefficients( ).
+- Each structure is compiled as its own block loop; setParameters( ) picks the loop once, so
+  processBlock( ) does not branch on the structure and keeps the states in registers for the block.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class Biquad : public IAudioSignalProcessor
+template <typename SampleType>
+class Biquad : public IAudioSignalProcessor<SampleType>
 {
 public:
-    Biquad() {}		/* C-TOR */
+    Biquad() { selectBlockProcessors(); }		/* C-TOR */
     ~Biquad() {}	/* D-TOR */
 
     // --- IAudioSignalProcessor FUNCTIONS --- //
@@ -33,7 +38,7 @@ public:
     /** reset: clear out the state array (flush delays); can safely ignore sampleRate argument - we don't need/use it */
     virtual bool reset(double _sampleRate)
     {
-        memset(&stateArray[0], 0, sizeof(double) * numStates);
+        memset(&stateArray[0], 0, sizeof(SampleType) * numStates);
         return true;  // handled = true
     }
 
@@ -45,7 +50,25 @@ public:
     \param xn input
     \return the processed sample
     */
-    virtual double processAudioSample(double xn);
+    virtual SampleType processAudioSample(SampleType xn);
+
+    /** process a block of input samples through the biquad */
+    /**
+    \param input input samples
+    \param output output samples (may be the same buffer as input)
+    \param numSamples number of samples to process
+    */
+    virtual void processBlock(const SampleType* input, SampleType* output, int numSamples);
+
+    /** process a block of input samples through the biquad and mix in the dry input */
+    /**
+    \param input input samples
+    \param output output samples: dry * x(n) + wet * y(n) (may be the same buffer as input)
+    \param numSamples number of samples to process
+    \param wet gain of the biquad output y(n)
+    \param dry gain of the input x(n)
+    */
+    void processBlock(const SampleType* input, SampleType* output, int numSamples, SampleType wet, SampleType dry);
 
     /** get parameters: note use of custom structure for passing param data */
     /**
@@ -57,45 +80,63 @@ public:
     /**
     \param BiquadParameters custom data structure
     */
-    void setParameters(const BiquadParameters& _parameters) { parameters = _parameters; }
+    void setParameters(const BiquadParameters& _parameters)
+    {
+        parameters = _parameters;
+        selectBlockProcessors();
+    }
 
     // --- MUTATORS & ACCESSORS --- //
     /** set the coefficient array NOTE: passing by pointer to array; allows us to use "array notation" with pointers i.e. [ ] */
-    void setCoefficients(double* coeffs) {
-        // --- fast block memory copy:
-        memcpy(&coeffArray[0], &coeffs[0], sizeof(double) * numCoeffs);
+    void setCoefficients(const double* coeffs) {
+        // --- convert the (double precision) designs to our sample type
+        for (int i = 0; i < numCoeffs; i++)
+            coeffArray[i] = (SampleType)coeffs[i];
     }
 
     /** get the coefficient array for read/write access to the array (not used in current objects) */
-    double* getCoefficients()
+    SampleType* getCoefficients()
     {
         // --- read/write access to the array (not used)
         return &coeffArray[0];
     }
 
     /** get the state array for read/write access to the array (used only in direct form oscillator) */
-    double* getStateArray()
+    SampleType* getStateArray()
     {
         // --- read/write access to the array (used only in direct form oscillator)
         return &stateArray[0];
     }
 
     /** get the structure G (gain) value for Harma filters; see 2nd Ed FX book */
-    double getG_value() { return coeffArray[a0]; }
+    SampleType getG_value() { return coeffArray[a0]; }
 
     /** get the structure S (storage) value for Harma filters; see 2nd Ed FX book */
-    double getS_value();// { return storageComponent; }
+    SampleType getS_value() { return storageComponent; }
 
 protected:
     /** array of coefficients */
-    double coeffArray[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    SampleType coeffArray[numCoeffs] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
 
     /** array of state (z^-1) registers */
-    double stateArray[numStates] = { 0.0, 0.0, 0.0, 0.0 };
+    SampleType stateArray[numStates] = { 0.0, 0.0, 0.0, 0.0 };
 
     /** type of calculation (algorithm  structure) */
     BiquadParameters parameters;
 
     /** for Harma loop resolution */
-    double storageComponent = 0.0;
+    SampleType storageComponent = 0.0;
+
+private:
+    /** the block loop of one structure; MixDryWet adds the dry input to the output */
+    template <biquadAlgorithm Form, bool MixDryWet>
+    void processFormBlock(const SampleType* input, SampleType* output, int numSamples, SampleType wet, SampleType dry);
+
+    /** point the block processors at the loops of the current biquadCalcType */
+    void selectBlockProcessors();
+
+    using BlockProcessor = void (Biquad::*)(const SampleType*, SampleType*, int, SampleType, SampleType);
+
+    BlockProcessor blockProcessor = nullptr;		///< processBlock( )
+    BlockProcessor mixedBlockProcessor = nullptr;	///< processBlock( ) with wet/dry
 };
\ No newline at end of file
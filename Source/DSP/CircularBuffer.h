@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include "DelayTap.h"
+#include "DelayInterpolators.h"
+
 /**
 \class CircularBuffer
 \ingroup FX-Objects
@@ -15,8 +18,9 @@ The CircularBuffer object implements a simple circular buffer. It uses a wrap ma
 */
 /** A simple cyclic buffer: NOTE - this is NOT an IAudioSignalProcessor or IAudioSignalGenerator
     S must be a power of 2.
+    The Interpolator policy (see DelayInterpolators.h) does the fractional reads; the tap reads are always linear.
 */
-template <typename T>
+template <typename T, template <typename> class Interpolator = LinearInterpolator>
 class CircularBuffer
 {
 public:
@@ -24,18 +28,22 @@ public:
     ~CircularBuffer() {}	/* D-TOR */
 
                             /** flush buffer by resetting all values to 0.0 */
-    void flushBuffer() { memset(&buffer[0], 0, bufferLength * sizeof(T)); }
+    void flushBuffer()
+    {
+        memset(&buffer[0], 0, bufferLength * sizeof(T));
+        interpolator.flush();
+    }
 
     /** Create a buffer based on a target maximum in SAMPLES
     //	   do NOT call from realtime audio thread; do this prior to any processing */
     void createCircularBuffer(unsigned int _bufferLength)
     {
         // --- find nearest power of 2 for buffer, and create
-        createCircularBufferPowerOfTwo((unsigned int)(pow(2, ceil(log(_bufferLength) / log(2)))));
+        createCircularBufferPowerOfTwo(getPowerOfTwoLength(_bufferLength));
     }
 
     /** Create a buffer based on a target maximum in SAMPLESwhere the size is
-        pre-calculated as a power of two */
+        pre-calculated as a power of two; the current memory (owned or attached) is reused if it is big enough */
     void createCircularBufferPowerOfTwo(unsigned int _bufferLengthPowerOfTwo)
     {
         // --- reset to top
@@ -48,12 +56,38 @@ public:
         wrapMask = bufferLength - 1;
 
         // --- create new buffer
-        buffer.reset(new T[bufferLength]);
+        if (getStorageLength(bufferLength) > capacity)
+        {
+            ownedBuffer.reset(new T[bufferLength]);
+            buffer = ownedBuffer.get();
+            capacity = bufferLength;
+        }
 
         // --- flush buffer
         flushBuffer();
     }
 
+    /** use external memory (e.g. from a DelayArena) of getStorageLength(_bufferLengthPowerOfTwo) samples
+        for the buffer; the caller keeps ownership */
+    void attachBuffer(T* memory, unsigned int _bufferLengthPowerOfTwo)
+    {
+        ownedBuffer.reset();
+        buffer = memory;
+        capacity = getStorageLength(_bufferLengthPowerOfTwo);
+
+        // --- reuses the memory we just attached
+        createCircularBufferPowerOfTwo(_bufferLengthPowerOfTwo);
+    }
+
+    /** nearest power of 2 at or above _bufferLength */
+    static unsigned int getPowerOfTwoLength(unsigned int _bufferLength)
+    {
+        return (unsigned int)(pow(2, ceil(log(_bufferLength) / log(2))));
+    }
+
+    /** samples of memory needed for a buffer of _bufferLengthPowerOfTwo */
+    static unsigned int getStorageLength(unsigned int _bufferLengthPowerOfTwo) { return _bufferLengthPowerOfTwo; }
+
     /** write a value into the buffer; this overwrites the previous oldest value in the buffer */
     void writeBuffer(T input)
     {
@@ -83,30 +117,155 @@ public:
     T readBuffer(double delayInFractionalSamples)
     {
         // --- truncate delayInFractionalSamples and read the int part
-        T y1 = readBuffer((int)delayInFractionalSamples);
+        int delayInSamples = (int)delayInFractionalSamples;
 
         // --- if no interpolation, just return value
-        if (!interpolate) return y1;
+        if (!interpolate) return readBuffer(delayInSamples);
 
-        // --- else do interpolation
-        //
-        // --- read the sample at n+1 (one sample OLDER)
-        T y2 = readBuffer((int)delayInFractionalSamples + 1);
+        // --- the four-point and allpass policies also read the sample one newer than x0
+        jassert(delayInSamples >= Interpolator<T>::MIN_DELAY_SAMPLES);
 
         // --- get fractional part
-        double fraction = delayInFractionalSamples - (int)delayInFractionalSamples;
+        double fraction = delayInFractionalSamples - delayInSamples;
+
+        // --- do the interpolation with the policy; readIndex is the int part location, as in readBuffer(int)
+        unsigned int readIndex = (writeIndex - 1) - delayInSamples;
+        return interpolator.read(&buffer[0], wrapMask, readIndex, (T)fraction);
+    }
+
+    /** write a block of values into the buffer */
+    void writeBlock(const T* input, int numSamples)
+    {
+        for (int i = 0; i < numSamples; i++)
+            writeBuffer(input[i]);
+    }
+
+    /** read a block for the numSamples that were just written with writeBlock( ): output[n] is the value
+        readBuffer(delayInFractionalSamples) would have returned just BEFORE sample n was written */
+    /**
+    NOTE: the buffer must hold delayInFractionalSamples + numSamples + 3 samples
+    */
+    void readBlock(double delayInFractionalSamples, T* output, int numSamples)
+    {
+        int delayInSamples = (int)delayInFractionalSamples;
+        unsigned int readIndex = writeIndex - numSamples - 1 - delayInSamples;
+
+        if (!interpolate)
+        {
+            for (int i = 0; i < numSamples; i++)
+                output[i] = buffer[(readIndex + i) & wrapMask];
+            return;
+        }
 
-        // --- do the interpolation (you could try different types here)
-        return doLinearInterpolation(y1, y2, fraction);
+        // --- the four-point and allpass policies also read the sample one newer than x0
+        jassert(delayInSamples >= Interpolator<T>::MIN_DELAY_SAMPLES);
+
+        T fraction = (T)(delayInFractionalSamples - delayInSamples);
+        for (int i = 0; i < numSamples; i++)
+            output[i] = interpolator.read(&buffer[0], wrapMask, readIndex + i, fraction);
     }
 
     /** enable or disable interpolation; usually used for diagnostics or in algorithms that require strict integer samples times */
     void setInterpolate(bool b) { interpolate = b; }
 
+    /** buffer length in samples (a power of 2) */
+    unsigned int getBufferLength() { return bufferLength; }
+
+    /** make a tap table entry for a read that includes a fractional sample; the split into integer and fraction
+        is done here once instead of on every read (the fraction is 0.0 if interpolation is off) */
+    DelayTap<T> makeTap(double delayInFractionalSamples, T gain = 1.0)
+    {
+        DelayTap<T> tap;
+        tap.delay_Samples = (int)delayInFractionalSamples;
+        tap.fraction = interpolate ? (T)(delayInFractionalSamples - tap.delay_Samples) : (T)0.0;
+        tap.gain = gain;
+        return tap;
+    }
+
+    /** read several taps at the current location: outputs[k] = gain * (interpolated) value of taps[k] */
+    void readTaps(const DelayTap<T>* taps, int numTaps, T* outputs)
+    {
+        for (int k = 0; k < numTaps; k++)
+        {
+            const DelayTap<T>& tap = taps[k];
+            unsigned int readIndex = writeIndex - 1 - tap.delay_Samples;
+
+            T y1 = buffer[readIndex & wrapMask];
+            if (tap.fraction != (T)0.0)
+                y1 = doLinearInterpolation(y1, buffer[(readIndex - 1) & wrapMask], tap.fraction);
+
+            outputs[k] = tap.gain * y1;
+        }
+    }
+
+    /** mix several taps over the block of numSamples that was just written:
+        output[n] += gain * (interpolated) value of each tap at the time sample n was written */
+    /**
+    NOTE: the taps are mixed one after the other, so the sum for each sample is formed in the same order as
+          reading and adding them sample by sample; the buffer must hold delay_Samples + numSamples + 1 samples
+    */
+    void mixTapsBlock(const DelayTap<T>* taps, int numTaps, T* output, int numSamples)
+    {
+        for (int k = 0; k < numTaps; k++)
+        {
+            const DelayTap<T>& tap = taps[k];
+            jassert((unsigned int)(tap.delay_Samples + numSamples + 1) <= bufferLength);
+
+            // --- location read for the first sample of the block; the reads for the block are contiguous
+            //     in memory apart from the wrap, so each run is a simple loop the compiler vectorizes
+            unsigned int readIndex = (writeIndex - numSamples - tap.delay_Samples) & wrapMask;
+            int n = 0;
+
+            while (n < numSamples)
+            {
+                int runLength = numSamples - n;
+                if (runLength > (int)(bufferLength - readIndex))
+                    runLength = bufferLength - readIndex;
+
+                const T* y1 = &buffer[readIndex];
+                T* out = output + n;
+
+                if (tap.fraction == (T)0.0)
+                {
+                    for (int i = 0; i < runLength; i++)
+                        out[i] += tap.gain * y1[i];
+                }
+                else
+                {
+                    // --- the sample one older than y1[0] is at the top of the buffer when readIndex is 0
+                    int i = 0;
+                    if (readIndex == 0)
+                    {
+                        out[0] += tap.gain * doLinearInterpolation(y1[0], buffer[wrapMask], tap.fraction);
+                        i = 1;
+                    }
+
+                    T fraction = tap.fraction;
+                    if (fraction >= (T)1.0)
+                    {
+                        for (; i < runLength; i++)
+                            out[i] += tap.gain * y1[i - 1];
+                    }
+                    else
+                    {
+                        for (; i < runLength; i++)
+                            out[i] += tap.gain * (fraction * y1[i - 1] + ((T)1.0 - fraction) * y1[i]);
+                    }
+                }
+
+                n += runLength;
+                readIndex = (readIndex + runLength) & wrapMask;
+            }
+        }
+    }
+
 private:
-    std::unique_ptr<T[]> buffer = nullptr;	///< smart pointer will auto-delete
+    std::unique_ptr<T[]> ownedBuffer = nullptr;	///< smart pointer will auto-delete; empty if the memory is attached
+    T* buffer = nullptr;				///< buffer memory, owned or attached
+    unsigned int capacity = 0;			///< samples available at buffer
     unsigned int writeIndex = 0;		///> write index
     unsigned int bufferLength = 1024;	///< must be nearest power of 2
     unsigned int wrapMask = 1023;		///< must be (bufferLength - 1)
     bool interpolate = true;			///< interpolation (default is ON)
+    Interpolator<T> interpolator;		///< fractional read policy
 };
\ No newline at end of file
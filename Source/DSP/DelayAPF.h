@@ -16,13 +16,23 @@ Audio I/O:
 
 Control I/F:
 - Use DelayAPFParameters structure to get/set object params.
+- Template parameter T is the sample type (float or double); the LFO and delay time math stay in double.
+- Template parameter Interpolator is the fractional delay interpolator policy for the modulated read (see
+  DelayInterpolators.h); it is used when DelayAPFParameters::interpolate is set.
+- processBlock( ) renders the LFO a block at a time, or call renderModulationBlock( ) before a run of
+  processAudioSample( ) calls to do the same.
+- With lfoUpdateInterval = N > 1 the LFO runs at control rate: it is evaluated once every N samples (and
+  advanced N samples each time, so it keeps its rate) and the modulated delay time is linearly interpolated
+  from the value at the start of each interval to the value at its end.
+- setParameters( ) does not touch the LFO itself; use setLFOParameters( ) for its waveform and rate.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class DelayAPF : public IAudioSignalProcessor
+template <typename T, template <typename> class Interpolator = LinearInterpolator>
+class DelayAPF : public IAudioSignalProcessor<T>
 {
 public:
     DelayAPF(void) {}	/* C-TOR */
@@ -32,50 +42,48 @@ public:
     /** reset members to initialized state */
     virtual bool reset(double _sampleRate)
     {
-        // --- reset children
+        sampleRate = _sampleRate;
+
+        // --- reset children; the delay line flushes, or re-slices its buffer for a new sample rate
         modLFO.reset(_sampleRate);
+        delay.reset(_sampleRate);
 
         // --- flush
-        lpf_state = 0.0;
-
-        // --- create new buffer, will store sample rate and length(mSec)
-        createDelayBuffer(sampleRate, bufferLength_mSec);
+        clearState();
 
         return true;
     }
 
+    /** back to the state right after reset( ): flush the delay line, LPF and modulation (the LFO restarts);
+        the sample rate and buffer are unchanged and nothing is allocated */
+    virtual void flush()
+    {
+        modLFO.reset(sampleRate);
+        delay.flush();
+        clearState();
+    }
+
     /** process one input sample through object */
     /**
     \param xn input
     \return the processed sample
     */
-    virtual double processAudioSample(double xn)
+    virtual T processAudioSample(T xn)
     {
         SimpleDelayParameters delayParams = delay.getParameters();
         if (delayParams.delay_Samples == 0)
             return xn;
 
         // --- delay line output
-        double wnD = 0.0;
-        double apf_g = delayAPFParameters.apf_g;
-        double lpf_g = delayAPFParameters.lpf_g;
-        double lfoDepth = delayAPFParameters.lfoDepth;
+        T wnD = 0.0;
+        T apf_g = (T)delayAPFParameters.apf_g;
+        T lpf_g = (T)delayAPFParameters.lpf_g;
 
         // --- for modulated APFs
         if (delayAPFParameters.enableLFO)
         {
-            SignalGenData lfoOutput = modLFO.renderAudioOutput();
-            double maxDelay = delayParams.delayTime_mSec;
-            double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
-            minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
-
-            // --- calc max-down modulated value with unipolar converted LFO output
-            //     NOTE: LFO output is scaled by lfoDepth
-            double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth * lfoOutput.normalOutput),
-                minDelay, maxDelay);
-
             // --- read modulated value to get w(n-D);
-            wnD = delay.readDelayAtTime_mSec(modDelay_mSec);
+            wnD = delay.readDelayAtTime_mSec(getNextModulatedDelay_mSec());
         }
         else
             // --- read the delay line to get w(n-D)
@@ -84,15 +92,15 @@ public:
         if (delayAPFParameters.enableLPF)
         {
             // --- apply simple 1st order pole LPF, overwrite wnD
-            wnD = wnD * (1.0 - lpf_g) + lpf_g * lpf_state;
+            wnD = wnD * ((T)1.0 - lpf_g) + lpf_g * lpf_state;
             lpf_state = wnD;
         }
 
         // form w(n) = x(n) + gw(n-D)
-        double wn = xn + apf_g * wnD;
+        T wn = xn + apf_g * wnD;
 
         // form y(n) = -gw(n) + w(n-D)
-        double yn = -apf_g * wn + wnD;
+        T yn = -apf_g * wn + wnD;
 
         // underflow check
         checkFloatUnderflow(yn);
@@ -103,6 +111,54 @@ public:
         return yn;
     }
 
+    /** process a block of input samples through object */
+    /**
+    \param input input samples
+    \param output output samples (may be the same buffer as input)
+    \param numSamples number of samples to process
+    */
+    virtual void processBlock(const T* input, T* output, int numSamples)
+    {
+        for (int offset = 0; offset < numSamples; offset += LFO_BLOCK_SIZE)
+        {
+            int blockSize = numSamples - offset;
+            if (blockSize > (int)LFO_BLOCK_SIZE)
+                blockSize = LFO_BLOCK_SIZE;
+
+            renderModulationBlock(blockSize);
+            for (int i = 0; i < blockSize; i++)
+                output[offset + i] = DelayAPF::processAudioSample(input[offset + i]);
+        }
+    }
+
+    /** render the LFO output for the next numSamples (at most LFO_BLOCK_SIZE) calls to processAudioSample( ) in one go */
+    void renderModulationBlock(int numSamples)
+    {
+        lfoBlockIndex = 0;
+        lfoBlockLength = 0;
+
+        // --- processAudioSample( ) does not run the LFO when the delay is 0 or the LFO is off
+        if (!delayAPFParameters.enableLFO || delay.getParameters().delay_Samples == 0)
+            return;
+
+        if (numSamples > (int)LFO_BLOCK_SIZE)
+            numSamples = LFO_BLOCK_SIZE;
+
+        // --- at control rate, the LFO is only evaluated when the update counter runs out; the first update
+        //     after a reset also needs the value at the start of its interval
+        int lfoInterval = getLFOUpdateInterval();
+        if (lfoInterval > 1)
+        {
+            lfoBlockLength = (int)lfoUpdateCounter < numSamples ? 1 + (numSamples - 1 - lfoUpdateCounter) / lfoInterval : 0;
+            if (lfoBlockLength > 0 && !modDelayStarted)
+                lfoBlockLength++;
+        }
+        else
+            lfoBlockLength = numSamples;
+
+        modLFO.renderBlock(lfoBlock, lfoBlockLength, generatorOutput::kNormal, lfoInterval);
+    }
+
     /** return false: this object only processes samples */
     virtual bool canProcessAudioFrame() { return false; }
 
@@ -121,14 +177,28 @@ public:
     */
     void setParameters(const DelayAPFParameters& params)
     {
+        // --- restart the control rate interpolation if its interval changed
+        if (params.lfoUpdateInterval != delayAPFParameters.lfoUpdateInterval)
+            lfoUpdateCounter = 0;
+
         delayAPFParameters = params;
 
         // --- update delay line
         SimpleDelayParameters delayParams = delay.getParameters();
         delayParams.delayTime_mSec = delayAPFParameters.delayTime_mSec;
+        delayParams.interpolate = delayAPFParameters.interpolate;
         delay.setParameters(delayParams);
     }
 
+    /** get the LFO parameters */
+    OscillatorParameters getLFOParameters() { return modLFO.getParameters(); }
+
+    /** set the LFO waveform and rate; the rate is the same at audio and control rate */
+    /**
+    \param params OscillatorParameters custom data structure
+    */
+    void setLFOParameters(const OscillatorParameters& params) { modLFO.setParameters(params); }
+
     /** create the delay buffer in mSec */
     void createDelayBuffer(double _sampleRate, double delay_mSec)
     {
@@ -139,18 +209,112 @@ public:
         delay.createDelayBuffer(_sampleRate, delay_mSec);
     }
 
+    /** create the delay buffer in mSec, in memory carved from a DelayArena */
+    void createDelayBuffer(double _sampleRate, double delay_mSec, DelayArena<T>& arena)
+    {
+        sampleRate = _sampleRate;
+        bufferLength_mSec = delay_mSec;
+
+        delay.createDelayBuffer(_sampleRate, delay_mSec, arena);
+    }
+
 protected:
+    /** clear the LPF and control rate modulation state */
+    void clearState()
+    {
+        lpf_state = 0.0;
+        lfoBlockLength = 0;
+        lfoBlockIndex = 0;
+        lfoUpdateCounter = 0;
+        modDelayStarted = false;
+    }
+
+    /** the next LFO output: from the block rendered by renderModulationBlock( ), or rendered now if that is used up */
+    /**
+    \param stride number of samples the LFO advances per output (the update interval)
+    */
+    inline double getNextLFOOutput(int stride)
+    {
+        if (lfoBlockIndex < lfoBlockLength)
+            return lfoBlock[lfoBlockIndex++];
+
+        if (stride == 1)
+            return modLFO.renderAudioOutput().normalOutput;
+
+        double lfoOutput = 0.0;
+        modLFO.renderBlock(&lfoOutput, 1, generatorOutput::kNormal, stride);
+        return lfoOutput;
+    }
+
+    /** LFO update interval in samples, at least 1 */
+    inline int getLFOUpdateInterval() { return delayAPFParameters.lfoUpdateInterval > 1 ? (int)delayAPFParameters.lfoUpdateInterval : 1; }
+
+    /** calculate the modulated delay time for an LFO output value */
+    inline double calculateModulatedDelay_mSec(double lfoOutput)
+    {
+        double maxDelay = delay.getParameters().delayTime_mSec;
+        double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
+        minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
+
+        // --- the four-point and allpass interpolators need at least one sample of delay
+        if (Interpolator<T>::MIN_DELAY_SAMPLES > 0 && delayAPFParameters.interpolate)
+            minDelay = fmax(Interpolator<T>::MIN_DELAY_SAMPLES * 1000.0 / sampleRate, minDelay);
+
+        // --- calc max-down modulated value with unipolar converted LFO output
+        //     NOTE: LFO output is scaled by lfoDepth
+        return doUnipolarModulationFromMax(bipolarToUnipolar(delayAPFParameters.lfoDepth * lfoOutput),
+            minDelay, maxDelay);
+    }
+
+    /** the modulated delay time for the next sample, from the LFO at audio or control rate */
+    inline double getNextModulatedDelay_mSec()
+    {
+        int lfoInterval = getLFOUpdateInterval();
+        if (lfoInterval == 1)
+            return calculateModulatedDelay_mSec(getNextLFOOutput(1));
+
+        // --- control rate: ramp from the LFO value at the start of the interval to the one at its end
+        if (lfoUpdateCounter == 0)
+        {
+            if (!modDelayStarted)
+            {
+                modDelayTarget_mSec = calculateModulatedDelay_mSec(getNextLFOOutput(lfoInterval));
+                modDelayStarted = true;
+            }
+
+            modDelay_mSec = modDelayTarget_mSec;
+            modDelayTarget_mSec = calculateModulatedDelay_mSec(getNextLFOOutput(lfoInterval));
+            modDelayIncrement_mSec = (modDelayTarget_mSec - modDelay_mSec) / lfoInterval;
+            lfoUpdateCounter = lfoInterval;
+        }
+
+        lfoUpdateCounter--;
+        double delay_mSec = modDelay_mSec;
+        modDelay_mSec += modDelayIncrement_mSec;
+        return delay_mSec;
+    }
+
     // --- component parameters
     DelayAPFParameters delayAPFParameters;	///< obeject parameters
     double sampleRate = 0.0;				///< current sample rate
     double bufferLength_mSec = 0.0;			///< total buffer length in mSec
 
-    // --- delay buffer of doubles
-    SimpleDelay delay;						///< delay
+    // --- delay buffer of samples
+    SimpleDelay<T, Interpolator> delay;		///< delay
 
     // --- optional LFO
     LFO modLFO;								///< LFO
+    double lfoBlock[LFO_BLOCK_SIZE] = { 0.0 };	///< LFO output rendered ahead
+    int lfoBlockLength = 0;					///< number of valid samples in lfoBlock
+    int lfoBlockIndex = 0;					///< next sample to use from lfoBlock
+
+    // --- control rate modulation
+    unsigned int lfoUpdateCounter = 0;		///< samples to go until the next LFO update
+    double modDelay_mSec = 0.0;				///< current (interpolated) modulated delay time
+    double modDelayTarget_mSec = 0.0;		///< modulated delay time at the end of the current interval
+    double modDelayIncrement_mSec = 0.0;	///< per sample delay time increment towards modDelayTarget_mSec
+    bool modDelayStarted = false;			///< false until the first LFO update after a reset
 
     // --- LPF support
-    double lpf_state = 0.0;					///< LPF state register (z^-1)
+    T lpf_state = 0.0;						///< LPF state register (z^-1)
 };
\ No newline at end of file
@@ -31,6 +31,7 @@ struct DelayAPFParameters
         lfoRate_Hz = params.lfoRate_Hz;
         lfoDepth = params.lfoDepth;
         lfoMaxModulation_mSec = params.lfoMaxModulation_mSec;
+        lfoUpdateInterval = params.lfoUpdateInterval;
         return *this;
     }
 
@@ -44,4 +45,5 @@ struct DelayAPFParameters
     double lfoRate_Hz = 0.0;		///< LFO rate in Hz, if enabled
     double lfoDepth = 0.0;			///< LFO deoth (not in %) if enabled
     double lfoMaxModulation_mSec = 0.0;	///< LFO maximum modulation time in mSec
+    unsigned int lfoUpdateInterval = 1;	///< evaluate the LFO every N samples, interpolating the delay time in between (1 = every sample)
 };
\ No newline at end of file
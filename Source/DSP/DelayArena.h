@@ -0,0 +1,108 @@
+// DelayArena.h
+
+#pragma once
+
+// --- alignment of the delay lines carved from a DelayArena
+const unsigned int kDelayArenaAlignment_Bytes = 64; // one cache line
+
+/**
+\class DelayArena
+\ingroup FX-Objects
+\brief
+The DelayArena object owns ONE cache-line-aligned block of memory that a group of delay lines is carved from,
+in the order the lines are created, so an algorithm's delay memory is a single allocation laid out in
+processing order.
+
+Laying out takes two passes over the same createDelayBuffer( ) calls:
+- beginLayout( ), then create the delay lines: carve( ) only adds up the memory and returns nullptr
+- allocate( ), then create the delay lines again: carve( ) hands out the slices
+
+allocate( ) only goes to the heap if the layout is bigger than the memory the arena already has. To re-slice
+memory that was laid out for a bigger set of lines (e.g. the same lines at a higher sample rate), call
+rewind( ) instead and create the delay lines once.
+
+NOTE: this is NOT an IAudioSignalProcessor; do NOT call allocate( ) from the realtime audio thread.
+*/
+template <typename T>
+class DelayArena
+{
+public:
+    DelayArena() {}		/* C-TOR */
+    ~DelayArena() {}	/* D-TOR */
+
+    /** start a layout pass: carve( ) counts the memory it is asked for */
+    void beginLayout()
+    {
+        measuring = true;
+        layoutLength = 0;
+    }
+
+    /** allocate the memory counted since beginLayout( ), if needed, and start carving from the top */
+    void allocate()
+    {
+        if (layoutLength > capacity)
+        {
+            // --- extra room to align the start
+            const size_t alignmentSamples = kDelayArenaAlignment_Bytes / sizeof(T);
+            memory.reset(new T[layoutLength + alignmentSamples]);
+
+            uintptr_t address = (uintptr_t)memory.get();
+            address = (address + kDelayArenaAlignment_Bytes - 1) & ~((uintptr_t)kDelayArenaAlignment_Bytes - 1);
+            alignedMemory = (T*)address;
+
+            capacity = layoutLength;
+            numAllocations++;
+        }
+
+        rewind();
+    }
+
+    /** start carving from the top of the memory already allocated, with no layout pass; the slices must fit */
+    void rewind()
+    {
+        measuring = false;
+        carveOffset = 0;
+    }
+
+    /** get the next cache-line-aligned slice of numSamples; returns nullptr during the layout pass */
+    T* carve(size_t numSamples)
+    {
+        size_t alignedLength = getAlignedLength(numSamples);
+
+        if (measuring)
+        {
+            layoutLength += alignedLength;
+            return nullptr;
+        }
+
+        jassert(carveOffset + alignedLength <= capacity);
+        T* slice = alignedMemory + carveOffset;
+        carveOffset += alignedLength;
+        return slice;
+    }
+
+    /** samples of memory the arena holds */
+    size_t getCapacity() const { return capacity; }
+
+    /** samples carved since the last allocate( ) */
+    size_t getCarvedLength() const { return carveOffset; }
+
+    /** number of times the arena has gone to the heap */
+    int getNumAllocations() const { return numAllocations; }
+
+    /** numSamples rounded up to a whole number of cache lines */
+    static size_t getAlignedLength(size_t numSamples)
+    {
+        const size_t alignmentSamples = kDelayArenaAlignment_Bytes / sizeof(T);
+        return (numSamples + alignmentSamples - 1) / alignmentSamples * alignmentSamples;
+    }
+
+private:
+    std::unique_ptr<T[]> memory = nullptr;	///< smart pointer will auto-delete
+    T* alignedMemory = nullptr;				///< first cache line boundary in memory
+    size_t capacity = 0;					///< samples available from alignedMemory
+    size_t layoutLength = 0;				///< samples counted in the layout pass
+    size_t carveOffset = 0;					///< next slice
+    bool measuring = false;					///< layout pass in progress
+    int numAllocations = 0;					///< heap allocations so far
+};
\ No newline at end of file
@@ -0,0 +1,170 @@
+// DelayInterpolators.h
+
+#pragma once
+
+/*
+Interpolator policies for CircularBuffer: each one reads the buffer around an integer read location and
+interpolates a fractional delay. The policy is a template parameter of CircularBuffer, SimpleDelay and
+DelayAPF, so there is no runtime switch in the read.
+
+read( ) arguments:
+- buffer, wrapMask: the circular buffer and its wrap mask
+- readIndex: location of the sample at the integer part of the delay (x0)
+- fraction: the fractional part of the delay [0.0, 1.0), towards the OLDER sample x1
+
+The four-point interpolators also use xm1, the sample one NEWER than x0, and x2, and the buffer must hold two
+samples past the longest integer delay. They and the allpass need a delay of at least MIN_DELAY_SAMPLES (one
+sample): with an integer delay of 0, xm1 is the oldest sample in the buffer, the next one to be overwritten.
+The buffers assert it and SimpleDelay and DelayAPF keep their delays at or above it.
+*/
+
+/**
+\struct NoInterpolator
+\ingroup FX-Objects
+\brief
+Interpolator policy for CircularBuffer: no interpolation, the fraction is ignored.
+*/
+template <typename T>
+struct NoInterpolator
+{
+    enum { MIN_DELAY_SAMPLES = 0 };
+
+    inline T read(const T* buffer, unsigned int wrapMask, unsigned int readIndex, T /*fraction*/)
+    {
+        return buffer[readIndex & wrapMask];
+    }
+
+    /** clear the interpolator state, if any */
+    void flush() {}
+};
+
+/**
+\struct LinearInterpolator
+\ingroup FX-Objects
+\brief
+Interpolator policy for CircularBuffer: linear interpolation between x0 and x1 (the default).
+*/
+template <typename T>
+struct LinearInterpolator
+{
+    enum { MIN_DELAY_SAMPLES = 0 };
+
+    inline T read(const T* buffer, unsigned int wrapMask, unsigned int readIndex, T fraction)
+    {
+        T x0 = buffer[readIndex & wrapMask];
+        T x1 = buffer[(readIndex - 1) & wrapMask];
+        return doLinearInterpolation(x0, x1, fraction);
+    }
+
+    /** clear the interpolator state, if any */
+    void flush() {}
+};
+
+/**
+\struct Lagrange3Interpolator
+\ingroup FX-Objects
+\brief
+Interpolator policy for CircularBuffer: third order Lagrange interpolation through xm1, x0, x1 and x2.
+*/
+template <typename T>
+struct Lagrange3Interpolator
+{
+    enum { MIN_DELAY_SAMPLES = 1 };	///< reads xm1
+
+    inline T read(const T* buffer, unsigned int wrapMask, unsigned int readIndex, T fraction)
+    {
+        T xm1 = buffer[(readIndex + 1) & wrapMask];
+        T x0 = buffer[readIndex & wrapMask];
+        T x1 = buffer[(readIndex - 1) & wrapMask];
+        T x2 = buffer[(readIndex - 2) & wrapMask];
+
+        // --- Lagrange basis polynomials for the points at -1, 0, 1, 2
+        T d = fraction;
+        T dp1 = d + (T)1.0;
+        T dm1 = d - (T)1.0;
+        T dm2 = d - (T)2.0;
+
+        T cm1 = -d * dm1 * dm2 * (T)(1.0 / 6.0);
+        T c0 = dp1 * dm1 * dm2 * (T)0.5;
+        T c1 = -dp1 * d * dm2 * (T)0.5;
+        T c2 = dp1 * d * dm1 * (T)(1.0 / 6.0);
+
+        return cm1 * xm1 + c0 * x0 + c1 * x1 + c2 * x2;
+    }
+
+    /** clear the interpolator state, if any */
+    void flush() {}
+};
+
+/**
+\struct HermiteInterpolator
+\ingroup FX-Objects
+\brief
+Interpolator policy for CircularBuffer: cubic Hermite (Catmull-Rom) interpolation between x0 and x1, with
+the slopes taken from xm1 and x2.
+*/
+template <typename T>
+struct HermiteInterpolator
+{
+    enum { MIN_DELAY_SAMPLES = 1 };	///< reads xm1
+
+    inline T read(const T* buffer, unsigned int wrapMask, unsigned int readIndex, T fraction)
+    {
+        T xm1 = buffer[(readIndex + 1) & wrapMask];
+        T x0 = buffer[readIndex & wrapMask];
+        T x1 = buffer[(readIndex - 1) & wrapMask];
+        T x2 = buffer[(readIndex - 2) & wrapMask];
+
+        T c1 = (T)0.5 * (x1 - xm1);
+        T c2 = xm1 - (T)2.5 * x0 + (T)2.0 * x1 - (T)0.5 * x2;
+        T c3 = (T)0.5 * (x2 - xm1) + (T)1.5 * (x0 - x1);
+
+        return ((c3 * fraction + c2) * fraction + c1) * fraction + x0;
+    }
+
+    /** clear the interpolator state, if any */
+    void flush() {}
+};
+
+/**
+\struct AllpassInterpolator
+\ingroup FX-Objects
+\brief
+Interpolator policy for CircularBuffer: first order allpass interpolation. It has a flat magnitude
+response, so modulated delays keep their highs, but it has state: use it for ONE read per sample, e.g. the
+modulated read of a DelayAPF, and not for taps.
+
+The allpass delay is kept in [0.5, 1.5) samples (by reading from xm1 when the fraction is below 0.5) so
+the coefficient stays away from the unstable ends of its range.
+*/
+template <typename T>
+struct AllpassInterpolator
+{
+    enum { MIN_DELAY_SAMPLES = 1 };	///< reads xm1 when the fraction is below 0.5
+
+    inline T read(const T* buffer, unsigned int wrapMask, unsigned int readIndex, T fraction)
+    {
+        T alpha = fraction;
+        if (alpha < (T)0.5)
+        {
+            readIndex++;
+            alpha += (T)1.0;
+        }
+
+        T x0 = buffer[readIndex & wrapMask];
+        T x1 = buffer[(readIndex - 1) & wrapMask];
+
+        // --- y(n) = eta * x0 + x1 - eta * y(n-1), with eta = (1 - alpha) / (1 + alpha)
+        T eta = ((T)1.0 - alpha) / ((T)1.0 + alpha);
+        T yn = eta * x0 + x1 - eta * z1;
+        checkFloatUnderflow(yn);
+        z1 = yn;
+
+        return yn;
+    }
+
+    /** clear the interpolator state */
+    void flush() { z1 = 0.0; }
+
+    T z1 = 0.0;	///< previous output
+};
\ No newline at end of file
@@ -0,0 +1,23 @@
+// DelayTap.h
+
+#pragma once
+
+/**
+\struct DelayTap
+\ingroup Structures
+\brief
+One entry of a tap table for the multi-tap reads of CircularBuffer and SimpleDelay: a precomputed read
+position (split into integer and fractional delay) and the gain applied to the tap.
+
+Build taps with CircularBuffer::makeTap( ) or SimpleDelay::getTapAtPercentage( ) when the delay
+settings change, not per sample.
+*/
+template <typename T>
+struct DelayTap
+{
+    DelayTap() {}
+
+    int delay_Samples = 0;	///< integer part of the delay in samples
+    T fraction = 0.0;		///< fractional part of the delay, 0.0 if not interpolating
+    T gain = 1.0;			///< gain applied to the tap output
+};
\ No newline at end of file
@@ -0,0 +1,131 @@
+// GainStage.h
+
+#pragma once
+
+/**
+\class GainStage
+\ingroup FX-Objects
+\brief
+The GainStage object implements a dB controlled gain with a sample-accurate linear ramp. The dB value is
+converted to a linear gain once, when it is set (at control rate), and the gain moves linearly to it
+over the ramp length given to startRamp( ).
+
+NOTE: this is NOT an IAudioSignalProcessor; the block functions do not advance the ramp so that several
+channels can be processed with the same gain, call advance( ) once all channels are done.
+
+Audio I/O:
+- Processes any number of channels, one block at a time.
+
+Control I/F:
+- Use setGain_dB( ) at control rate, then startRamp( ) at the top of the next block.
+- Template parameter T is the sample type (float or double) the gain is applied in.
+*/
+template <typename T>
+class GainStage
+{
+public:
+    GainStage() {}		/* C-TOR */
+    ~GainStage() {}		/* D-TOR */
+
+    /** jump straight to a gain with no ramp */
+    void reset(double _gain_dB)
+    {
+        gain_dB = _gain_dB;
+        gain = (T)pow(10.0, gain_dB / 20.0);
+        targetGain = gain;
+        gainIncrement = 0.0;
+        rampSamplesRemaining = 0;
+        newTargetPending = false;
+    }
+
+    /** set a new target gain; the only place the dB to linear conversion happens */
+    void setGain_dB(double _gain_dB)
+    {
+        if (_gain_dB == gain_dB)
+            return;
+
+        gain_dB = _gain_dB;
+        targetGain = (T)pow(10.0, gain_dB / 20.0);
+        newTargetPending = true;
+    }
+
+    /** ramp from the current gain to the target over numSamples; does nothing if the target did not change */
+    void startRamp(int numSamples)
+    {
+        if (!newTargetPending)
+            return;
+
+        newTargetPending = false;
+        if (numSamples < 1)
+            numSamples = 1;
+
+        gainIncrement = (targetGain - gain) / numSamples;
+        rampSamplesRemaining = numSamples;
+    }
+
+    /** true while the gain is still moving */
+    bool isRamping() { return rampSamplesRemaining > 0; }
+
+    /** get the gain for the next sample and advance the ramp by one sample (for per-sample processing) */
+    T getNextGain()
+    {
+        startRamp(1);
+        advance(1);
+        return gain;
+    }
+
+    /** output[i] = g(i) * input[i] for the next numSamples samples of the ramp; does not advance it */
+    void multiply(const T* input, T* output, int numSamples)
+    {
+        int rampLength = numSamples < rampSamplesRemaining ? numSamples : rampSamplesRemaining;
+
+        // --- the gain is computed from the index (not accumulated) so these loops vectorize
+        for (int i = 0; i < rampLength; i++)
+            output[i] = (gain + (T)(i + 1) * gainIncrement) * input[i];
+
+        T steadyGain = rampLength > 0 ? targetGain : gain;
+        for (int i = rampLength; i < numSamples; i++)
+            output[i] = steadyGain * input[i];
+    }
+
+    /** output[i] += g(i) * input[i] for the next numSamples samples of the ramp; does not advance it */
+    void multiplyAdd(const T* input, T* output, int numSamples)
+    {
+        int rampLength = numSamples < rampSamplesRemaining ? numSamples : rampSamplesRemaining;
+
+        for (int i = 0; i < rampLength; i++)
+            output[i] += (gain + (T)(i + 1) * gainIncrement) * input[i];
+
+        T steadyGain = rampLength > 0 ? targetGain : gain;
+        for (int i = rampLength; i < numSamples; i++)
+            output[i] += steadyGain * input[i];
+    }
+
+    /** move along the ramp once all channels of a block have been processed */
+    void advance(int numSamples)
+    {
+        if (rampSamplesRemaining <= 0)
+            return;
+
+        if (numSamples >= rampSamplesRemaining)
+        {
+            // --- land exactly on the target
+            gain = targetGain;
+            gainIncrement = 0.0;
+            rampSamplesRemaining = 0;
+        }
+        else
+        {
+            gain += (T)numSamples * gainIncrement;
+            rampSamplesRemaining -= numSamples;
+        }
+    }
+
+private:
+    double gain_dB = 0.0;			///< last gain set in dB
+    T gain = 1.0;					///< linear gain reached at the last processed sample
+    T targetGain = 1.0;				///< linear gain at the end of the ramp
+    T gainIncrement = 0.0;			///< linear gain change per sample
+    int rampSamplesRemaining = 0;	///< samples left in the current ramp
+    bool newTargetPending = false;	///< target changed, ramp not started yet
+};
@@ -10,12 +10,14 @@
 \ingroup Interfaces
 \brief
 Use this interface for objects that process audio input samples to produce audio output samples. A derived class must implement the three abstract methods. The others are optional.
+The interface is templated on the sample type (float or double) the object processes with.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
+template <typename SampleType>
 class IAudioSignalProcessor
 {
 public:
@@ -27,7 +29,7 @@ public:
     virtual bool reset(double _sampleRate) = 0;
 
     /** process one sample in and out */
-    virtual double processAudioSample(double xn) = 0;
+    virtual SampleType processAudioSample(SampleType xn) = 0;
 
     /** return true if the derived object can process a frame, false otherwise */
     virtual bool canProcessAudioFrame() = 0;
@@ -40,7 +42,7 @@ public:
 
     /** for processing objects with a sidechain input or other necessary aux input
             the return value is optional and will depend on the subclassed object */
-    virtual double processAuxInputAudioSample(double xn)
+    virtual SampleType processAuxInputAudioSample(SampleType xn)
     {
         // --- do nothing
         return xn;
@@ -50,12 +52,42 @@ public:
     --- optional processing function
         e.g. does not make sense for some objects to implement this such as inherently mono objects like Biquad
              BUT a processor that must use both left and right channels (ping-pong delay) would require it */
-    virtual bool processAudioFrame(const float* inputFrame,		/* ptr to one frame of data: pInputFrame[0] = left, pInputFrame[1] = right, etc...*/
-        float* outputFrame,
+    virtual bool processAudioFrame(const SampleType* inputFrame,		/* ptr to one frame of data: pInputFrame[0] = left, pInputFrame[1] = right, etc...*/
+        SampleType* outputFrame,
         uint32_t inputChannels,
         uint32_t outputChannels)
     {
         // --- do nothing
         return false; // NOT handled
     }
+
+    /** process a block of mono samples; the default implementation calls processAudioSample( ) for each sample,
+        derived objects override this to run their inner loop without a virtual call per sample
+        NOTE: input and output may point to the same buffer (in-place processing) */
+    virtual void processBlock(const SampleType* input, SampleType* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; i++)
+            output[i] = processAudioSample(input[i]);
+    }
+
+    /** process a block of non-interleaved multichannel audio; the default implementation marshals each
+        frame through processAudioFrame( ) so it is only useful for objects that can process frames
+        NOTE: inputs and outputs may point to the same buffers (in-place processing) */
+    virtual void processBlock(const SampleType* const* inputs, SampleType* const* outputs, int numChannels, int numSamples)
+    {
+        SampleType inputFrame[NUM_CHANNELS] = { 0.0 };
+        SampleType outputFrame[NUM_CHANNELS] = { 0.0 };
+        int frameChannels = numChannels < (int)NUM_CHANNELS ? numChannels : (int)NUM_CHANNELS;
+
+        for (int i = 0; i < numSamples; i++)
+        {
+            for (int ch = 0; ch < frameChannels; ch++)
+                inputFrame[ch] = inputs[ch][i];
+
+            processAudioFrame(inputFrame, outputFrame, frameChannels, frameChannels);
+
+            for (int ch = 0; ch < frameChannels; ch++)
+                outputs[ch][i] = outputFrame[ch];
+        }
+    }
 };
\ No newline at end of file
@@ -63,3 +63,97 @@ const SignalGenData LFO::renderAudioOutput()
 
     return output;
 }
+
+/**
+\brief renders one output for a block of samples: the modulo counters are advanced (and wrapped) one sample at
+a time as in renderAudioOutput( ), then the waveform is calculated for the whole block; the sin output uses
+the parabolic approximation on four samples at a time. With stride > 1 the counters move stride samples per
+output, which is the same as keeping every stride-th output of renderAudioOutput( ) (up to rounding).
+*/
+template <typename SampleType>
+void LFO::renderBlock(SampleType* dest, int numSamples, generatorOutput output, int stride)
+{
+    // --- the phase increment per output; stride 1 is exactly phaseInc
+    const double outputPhaseInc = stride > 1 ? phaseInc * stride : phaseInc;
+    const bool quadPhase = output == generatorOutput::kQuadPhasePos || output == generatorOutput::kQuadPhaseNeg;
+    const bool invert = output == generatorOutput::kInverted || output == generatorOutput::kQuadPhaseNeg;
+    generatorWaveform waveform = lfoParameters.waveform;
+
+    double moduloCounters[LFO_BLOCK_SIZE];
+    double values[LFO_BLOCK_SIZE];
+
+    for (int offset = 0; offset < numSamples; offset += LFO_BLOCK_SIZE)
+    {
+        int blockSize = numSamples - offset;
+        if (blockSize > (int)LFO_BLOCK_SIZE)
+            blockSize = LFO_BLOCK_SIZE;
+
+        // --- timebase
+        for (int n = 0; n < blockSize; n++)
+        {
+            checkAndWrapModulo(modCounter, outputPhaseInc);
+
+            if (quadPhase)
+            {
+                modCounterQP = modCounter;
+                advanceAndCheckWrapModulo(modCounterQP, 0.25);
+                moduloCounters[n] = modCounterQP;
+            }
+            else
+                moduloCounters[n] = modCounter;
+
+            advanceModulo(modCounter, outputPhaseInc);
+        }
+
+        // --- waveform
+        if (waveform == generatorWaveform::kSin)
+            parabolicSineBlock(moduloCounters, values, blockSize);
+        else if (waveform == generatorWaveform::kTriangle)
+        {
+            for (int n = 0; n < blockSize; n++)
+                values[n] = 2.0 * fabs(unipolarToBipolar(moduloCounters[n])) - 1.0;
+        }
+        else if (waveform == generatorWaveform::kSaw)
+        {
+            for (int n = 0; n < blockSize; n++)
+                values[n] = unipolarToBipolar(moduloCounters[n]);
+        }
+        else
+        {
+            for (int n = 0; n < blockSize; n++)
+                values[n] = 0.0;
+        }
+
+        for (int n = 0; n < blockSize; n++)
+            dest[offset + n] = (SampleType)(invert ? -values[n] : values[n]);
+    }
+}
+
+/**
+\brief parabolicSine(-angle) for a block of modulo counters, where angle = modCounter * 2.0 * kPi - kPi; the lane
+math is done in the same order as the scalar version so the results are identical.
+*/
+void LFO::parabolicSineBlock(const double* moduloCounters, double* output, int numSamples)
+{
+    typedef SIMDVector4<double> Lanes;
+
+    const Lanes b(B), c(C), p(P), two(2.0), pi(kPi);
+
+    int n = 0;
+    for (; n + 4 <= numSamples; n += 4)
+    {
+        // --- -angle = kPi - modCounter * 2.0 * kPi
+        Lanes angle = pi - Lanes::load(moduloCounters + n) * two * pi;
+
+        Lanes y = b * angle + c * angle * angle.abs();
+        y = p * (y * y.abs() - y) + y;
+        y.store(output + n);
+    }
+
+    for (; n < numSamples; n++)
+        output[n] = parabolicSine(-(moduloCounters[n] * 2.0 * kPi - kPi));
+}
+
+// --- sample types used by the plugin
+template void LFO::renderBlock<float>(float* dest, int numSamples, generatorOutput output, int stride);
+template void LFO::renderBlock<double>(double* dest, int numSamples, generatorOutput output, int stride);
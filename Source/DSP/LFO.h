@@ -7,6 +7,7 @@
 #include "OscillatorParameters.h"
 #include "SignalGenData.h"
 #include "Utilities.h"
+#include "SIMDVector4.h"
 
 /**
 \class LFO
@@ -67,6 +68,19 @@ public:
     /** render a new audio output structure */
     virtual const SignalGenData renderAudioOutput();
 
+    /** render a block of ONE of the outputs; advances the oscillator exactly like numSamples calls to
+        renderAudioOutput( ) and gives the same values, but skips the outputs that are not needed */
+    /**
+    NOTE: with stride = N > 1 the oscillator moves N samples per output, for control rate use: each output is
+          the value N samples after the one before (stride * frequency_Hz must stay below the sample rate)
+    \param dest output buffer
+    \param numSamples number of samples to render
+    \param output which of the SignalGenData outputs to render
+    \param stride number of samples the oscillator advances per output
+    */
+    template <typename SampleType>
+    void renderBlock(SampleType* dest, int numSamples, generatorOutput output = generatorOutput::kNormal, int stride = 1);
+
 protected:
     // --- parameters
     OscillatorParameters lfoParameters; ///< obejcgt parameters
@@ -135,4 +149,7 @@ protected:
         y = P * (y * fabs(y) - y) + y;
         return y;
     }
+
+    /** parabolicSine( ) of the sin output angle for a block of modulo counter values, four at a time */
+    void parabolicSineBlock(const double* moduloCounters, double* output, int numSamples);
 };
\ No newline at end of file
@@ -0,0 +1,282 @@
+// MirroredCircularBuffer.h
+
+#pragma once
+
+#include "DelayTap.h"
+#include "DelayInterpolators.h"
+
+// --- length of the mirrored guard region past the end of the MirroredCircularBuffer; block reads and
+//     writes longer than this are split into chunks
+const unsigned int MIRRORED_BUFFER_GUARD_LENGTH = 128;
+
+/**
+\class MirroredCircularBuffer
+\ingroup FX-Objects
+\brief
+The MirroredCircularBuffer object is a drop-in alternative storage for CircularBuffer (see SimpleDelay): the
+first MIRRORED_BUFFER_GUARD_LENGTH samples of the buffer are mirrored in a guard region past its end, so any
+run of up to that many samples starting inside the buffer is contiguous in memory.
+
+Every read wraps its index ONCE, at the oldest sample it needs; the interpolator and block loops then run
+on plain contiguous memory with no wrap logic. Writes store into the guard region too when they land in the
+mirrored part, which is a select rather than a branch.
+
+NOTE: this is NOT an IAudioSignalProcessor or IAudioSignalGenerator; the interface and results are the same
+as CircularBuffer.
+*/
+template <typename T, template <typename> class Interpolator = LinearInterpolator>
+class MirroredCircularBuffer
+{
+public:
+    MirroredCircularBuffer() {}		/* C-TOR */
+    ~MirroredCircularBuffer() {}	/* D-TOR */
+
+    /** flush buffer by resetting all values to 0.0 */
+    void flushBuffer()
+    {
+        memset(&buffer[0], 0, (bufferLength + MIRRORED_BUFFER_GUARD_LENGTH) * sizeof(T));
+        interpolator.flush();
+    }
+
+    /** Create a buffer based on a target maximum in SAMPLES
+    //	   do NOT call from realtime audio thread; do this prior to any processing */
+    void createCircularBuffer(unsigned int _bufferLength)
+    {
+        // --- find nearest power of 2 for buffer, and create
+        createCircularBufferPowerOfTwo(getPowerOfTwoLength(_bufferLength));
+    }
+
+    /** Create a buffer based on a target maximum in SAMPLES where the size is
+        pre-calculated as a power of two; the current memory (owned or attached) is reused if it is big enough */
+    void createCircularBufferPowerOfTwo(unsigned int _bufferLengthPowerOfTwo)
+    {
+        // --- reset to top
+        writeIndex = 0;
+
+        // --- the guard region must fit in the buffer for the mirror to stay consistent
+        bufferLength = _bufferLengthPowerOfTwo < MIRRORED_BUFFER_GUARD_LENGTH ? MIRRORED_BUFFER_GUARD_LENGTH : _bufferLengthPowerOfTwo;
+        wrapMask = bufferLength - 1;
+
+        // --- create new buffer with the guard region
+        if (getStorageLength(bufferLength) > capacity)
+        {
+            ownedBuffer.reset(new T[getStorageLength(bufferLength)]);
+            buffer = ownedBuffer.get();
+            capacity = getStorageLength(bufferLength);
+        }
+
+        // --- flush buffer
+        flushBuffer();
+    }
+
+    /** use external memory (e.g. from a DelayArena) of getStorageLength(_bufferLengthPowerOfTwo) samples
+        for the buffer; the caller keeps ownership */
+    void attachBuffer(T* memory, unsigned int _bufferLengthPowerOfTwo)
+    {
+        ownedBuffer.reset();
+        buffer = memory;
+        capacity = getStorageLength(_bufferLengthPowerOfTwo);
+
+        // --- reuses the memory we just attached
+        createCircularBufferPowerOfTwo(_bufferLengthPowerOfTwo);
+    }
+
+    /** nearest power of 2 at or above _bufferLength */
+    static unsigned int getPowerOfTwoLength(unsigned int _bufferLength)
+    {
+        return (unsigned int)(pow(2, ceil(log(_bufferLength) / log(2))));
+    }
+
+    /** samples of memory needed for a buffer of _bufferLengthPowerOfTwo, including the guard region */
+    static unsigned int getStorageLength(unsigned int _bufferLengthPowerOfTwo)
+    {
+        if (_bufferLengthPowerOfTwo < MIRRORED_BUFFER_GUARD_LENGTH)
+            _bufferLengthPowerOfTwo = MIRRORED_BUFFER_GUARD_LENGTH;
+
+        return _bufferLengthPowerOfTwo + MIRRORED_BUFFER_GUARD_LENGTH;
+    }
+
+    /** write a value into the buffer; this overwrites the previous oldest value in the buffer */
+    void writeBuffer(T input)
+    {
+        buffer[writeIndex] = input;
+
+        // --- mirror into the guard region; outside the mirrored part this rewrites the same location
+        buffer[writeIndex < MIRRORED_BUFFER_GUARD_LENGTH ? writeIndex + bufferLength : writeIndex] = input;
+
+        writeIndex = (writeIndex + 1) & wrapMask;
+    }
+
+    /** write a block of values into the buffer */
+    void writeBlock(const T* input, int numSamples)
+    {
+        while (numSamples > 0)
+        {
+            int runLength = numSamples;
+            if (runLength > (int)(bufferLength - writeIndex))
+                runLength = bufferLength - writeIndex;
+
+            memcpy(&buffer[writeIndex], input, runLength * sizeof(T));
+
+            // --- mirror the part that landed in the first MIRRORED_BUFFER_GUARD_LENGTH samples
+            if (writeIndex < MIRRORED_BUFFER_GUARD_LENGTH)
+            {
+                int mirrorLength = MIRRORED_BUFFER_GUARD_LENGTH - writeIndex;
+                if (mirrorLength > runLength)
+                    mirrorLength = runLength;
+
+                memcpy(&buffer[writeIndex + bufferLength], input, mirrorLength * sizeof(T));
+            }
+
+            writeIndex = (writeIndex + runLength) & wrapMask;
+            input += runLength;
+            numSamples -= runLength;
+        }
+    }
+
+    /** read an arbitrary location that is delayInSamples old */
+    T readBuffer(int delayInSamples)
+    {
+        // --- -1 here is because we read-before-write
+        return buffer[(writeIndex - 1 - delayInSamples) & wrapMask];
+    }
+
+    /** read an arbitrary location that includes a fractional sample */
+    T readBuffer(double delayInFractionalSamples)
+    {
+        int delayInSamples = (int)delayInFractionalSamples;
+
+        // --- if no interpolation, just return value
+        if (!interpolate) return readBuffer(delayInSamples);
+
+        // --- the four-point and allpass policies also read the sample one newer than x0
+        jassert(delayInSamples >= Interpolator<T>::MIN_DELAY_SAMPLES);
+
+        // --- wrap at the oldest sample the interpolator reads (x2), then the reads are contiguous
+        unsigned int oldestIndex = (writeIndex - 1 - delayInSamples - OLDER_SAMPLES) & wrapMask;
+        T fraction = (T)(delayInFractionalSamples - delayInSamples);
+
+        return interpolator.read(&buffer[0], ~0u, oldestIndex + OLDER_SAMPLES, fraction);
+    }
+
+    /** read a block for the numSamples that were just written with writeBlock( ): output[n] is the value
+        readBuffer(delayInFractionalSamples) would have returned just BEFORE sample n was written */
+    /**
+    NOTE: the buffer must hold delayInFractionalSamples + numSamples + 3 samples
+    */
+    void readBlock(double delayInFractionalSamples, T* output, int numSamples)
+    {
+        int delayInSamples = (int)delayInFractionalSamples;
+        jassert(!interpolate || delayInSamples >= Interpolator<T>::MIN_DELAY_SAMPLES);
+        T fraction = (T)(delayInFractionalSamples - delayInSamples);
+        unsigned int readIndex = writeIndex - numSamples - 1 - delayInSamples;
+
+        for (int offset = 0; offset < numSamples; offset += MAX_CONTIGUOUS_READ)
+        {
+            int blockSize = numSamples - offset;
+            if (blockSize > MAX_CONTIGUOUS_READ)
+                blockSize = MAX_CONTIGUOUS_READ;
+
+            unsigned int oldestIndex = (readIndex + offset - OLDER_SAMPLES) & wrapMask;
+            const T* x0 = &buffer[oldestIndex + OLDER_SAMPLES];
+            T* out = output + offset;
+
+            if (!interpolate)
+            {
+                for (int i = 0; i < blockSize; i++)
+                    out[i] = x0[i];
+            }
+            else
+            {
+                for (int i = 0; i < blockSize; i++)
+                    out[i] = interpolator.read(&buffer[0], ~0u, oldestIndex + OLDER_SAMPLES + i, fraction);
+            }
+        }
+    }
+
+    /** enable or disable interpolation; usually used for diagnostics or in algorithms that require strict integer samples times */
+    void setInterpolate(bool b) { interpolate = b; }
+
+    /** buffer length in samples (a power of 2), not counting the guard region */
+    unsigned int getBufferLength() { return bufferLength; }
+
+    /** make a tap table entry for a read that includes a fractional sample; see CircularBuffer::makeTap( ) */
+    DelayTap<T> makeTap(double delayInFractionalSamples, T gain = 1.0)
+    {
+        DelayTap<T> tap;
+        tap.delay_Samples = (int)delayInFractionalSamples;
+        tap.fraction = interpolate ? (T)(delayInFractionalSamples - tap.delay_Samples) : (T)0.0;
+        tap.gain = gain;
+        return tap;
+    }
+
+    /** read several taps at the current location: outputs[k] = gain * (interpolated) value of taps[k] */
+    void readTaps(const DelayTap<T>* taps, int numTaps, T* outputs)
+    {
+        for (int k = 0; k < numTaps; k++)
+        {
+            const DelayTap<T>& tap = taps[k];
+            const T* x1 = &buffer[(writeIndex - 2 - tap.delay_Samples) & wrapMask];
+
+            T y1 = x1[1];
+            if (tap.fraction != (T)0.0)
+                y1 = doLinearInterpolation(y1, x1[0], tap.fraction);
+
+            outputs[k] = tap.gain * y1;
+        }
+    }
+
+    /** mix several taps over the block of numSamples that was just written; see CircularBuffer::mixTapsBlock( ) */
+    void mixTapsBlock(const DelayTap<T>* taps, int numTaps, T* output, int numSamples)
+    {
+        for (int k = 0; k < numTaps; k++)
+        {
+            const DelayTap<T>& tap = taps[k];
+            jassert((unsigned int)(tap.delay_Samples + numSamples + 1) <= bufferLength);
+
+            for (int offset = 0; offset < numSamples; offset += MAX_CONTIGUOUS_READ)
+            {
+                int blockSize = numSamples - offset;
+                if (blockSize > MAX_CONTIGUOUS_READ)
+                    blockSize = MAX_CONTIGUOUS_READ;
+
+                // --- x1 is one sample older than the first read; from there the run is contiguous
+                const T* x1 = &buffer[(writeIndex - numSamples + offset - 1 - tap.delay_Samples) & wrapMask];
+                const T* y1 = x1 + 1;
+                T* out = output + offset;
+                T fraction = tap.fraction;
+
+                if (fraction == (T)0.0)
+                {
+                    for (int i = 0; i < blockSize; i++)
+                        out[i] += tap.gain * y1[i];
+                }
+                else if (fraction >= (T)1.0)
+                {
+                    for (int i = 0; i < blockSize; i++)
+                        out[i] += tap.gain * x1[i];
+                }
+                else
+                {
+                    for (int i = 0; i < blockSize; i++)
+                        out[i] += tap.gain * (fraction * x1[i] + ((T)1.0 - fraction) * y1[i]);
+                }
+            }
+        }
+    }
+
+private:
+    // --- samples older than x0 the interpolators read, and the longest run that stays inside the guard region
+    //     (with room for the newer sample xm1)
+    static const unsigned int OLDER_SAMPLES = 2;
+    static const int MAX_CONTIGUOUS_READ = MIRRORED_BUFFER_GUARD_LENGTH - OLDER_SAMPLES - 1;
+
+    std::unique_ptr<T[]> ownedBuffer = nullptr;	///< smart pointer will auto-delete; empty if the memory is attached
+    T* buffer = nullptr;				///< buffer memory, owned or attached
+    unsigned int capacity = 0;			///< samples available at buffer, including the guard region
+    unsigned int writeIndex = 0;		///< write index
+    unsigned int bufferLength = 1024;	///< must be nearest power of 2
+    unsigned int wrapMask = 1023;		///< must be (bufferLength - 1)
+    bool interpolate = true;			///< interpolation (default is ON)
+    Interpolator<T> interpolator;		///< fractional read policy
+};
\ No newline at end of file
@@ -19,14 +19,26 @@ Audio I/O:
 
 Control I/F:
 - Use BiquadParameters structure to get/set object params.
+- Template parameter T is the sample type (float or double).
+- Template parameter Interpolator is the fractional delay interpolator policy (see DelayInterpolators.h);
+  the modulated outer read uses it when NestedDelayAPFParameters::interpolate is set.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class NestedDelayAPF : public DelayAPF
+template <typename T, template <typename> class Interpolator = LinearInterpolator>
+class NestedDelayAPF : public DelayAPF<T, Interpolator>
 {
+    typedef DelayAPF<T, Interpolator> OuterAPF;
+
+    // --- members of the (dependent) base class
+    using OuterAPF::delayAPFParameters;
+    using OuterAPF::delay;
+    using OuterAPF::getNextModulatedDelay_mSec;
+    using OuterAPF::lpf_state;
+
 public:
     NestedDelayAPF(void) { }	/* C-TOR */
     ~NestedDelayAPF(void) { }	/* D-TOR */
@@ -36,7 +48,7 @@ public:
     virtual bool reset(double _sampleRate)
     {
         // --- call base class reset first
-        DelayAPF::reset(_sampleRate);
+        OuterAPF::reset(_sampleRate);
 
         // --- then do our stuff
         nestedAPF.reset(_sampleRate);
@@ -44,39 +56,35 @@ public:
         return true;
     }
 
+    /** flush both APFs; nothing is allocated */
+    virtual void flush()
+    {
+        OuterAPF::flush();
+        nestedAPF.flush();
+    }
+
     /** process mono audio input */
     /**
     \param xn input
     \return the processed sample
     */
-    virtual double processAudioSample(double xn)
+    virtual T processAudioSample(T xn)
     {
         // --- delay line output
-        double wnD = 0.0;
+        T wnD = 0.0;
 
         SimpleDelayParameters delayParams = delay.getParameters();
         if (delayParams.delay_Samples == 0)
             return xn;
 
-        double apf_g = delayAPFParameters.apf_g;
-        double lpf_g = delayAPFParameters.lpf_g;
+        T apf_g = (T)delayAPFParameters.apf_g;
+        T lpf_g = (T)delayAPFParameters.lpf_g;
 
         // --- for modulated APFs
         if (delayAPFParameters.enableLFO)
         {
-            SignalGenData lfoOutput = modLFO.renderAudioOutput();
-            double maxDelay = delayParams.delayTime_mSec;
-            double minDelay = maxDelay - delayAPFParameters.lfoMaxModulation_mSec;
-            minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
-            double lfoDepth = delayAPFParameters.lfoDepth;
-
-            // --- calc max-down modulated value with unipolar converted LFO output
-            //     NOTE: LFO output is scaled by lfoDepth
-            double modDelay_mSec = doUnipolarModulationFromMax(bipolarToUnipolar(lfoDepth * lfoOutput.normalOutput),
-                minDelay, maxDelay);
-
             // --- read modulated value to get w(n-D);
-            wnD = delay.readDelayAtTime_mSec(modDelay_mSec);
+            wnD = delay.readDelayAtTime_mSec(getNextModulatedDelay_mSec());
         }
         else
             // --- read the delay line to get w(n-D)
@@ -85,18 +93,18 @@ public:
         if (delayAPFParameters.enableLPF)
         {
             // --- apply simple 1st order pole LPF, overwrite wnD
-            wnD = wnD * (1.0 - lpf_g) + lpf_g * lpf_state;
+            wnD = wnD * ((T)1.0 - lpf_g) + lpf_g * lpf_state;
             lpf_state = wnD;
         }
 
         // --- form w(n) = x(n) + gw(n-D)
-        double wn = xn + apf_g * wnD;
+        T wn = xn + apf_g * wnD;
 
         // --- process wn through inner APF
-        double ynInner = nestedAPF.processAudioSample(wn);
+        T ynInner = nestedAPF.processAudioSample(wn);
 
         // --- form y(n) = -gw(n) + w(n-D)
-        double yn = -apf_g * wn + wnD;
+        T yn = -apf_g * wn + wnD;
 
         // --- underflow check
         checkFloatUnderflow(yn);
@@ -107,6 +115,27 @@ public:
         return yn;
     }
 
+    /** process a block of mono audio input */
+    /**
+    \param input input samples
+    \param output output samples (may be the same buffer as input)
+    \param numSamples number of samples to process
+    */
+    virtual void processBlock(const T* input, T* output, int numSamples)
+    {
+        for (int offset = 0; offset < numSamples; offset += LFO_BLOCK_SIZE)
+        {
+            int blockSize = numSamples - offset;
+            if (blockSize > (int)LFO_BLOCK_SIZE)
+                blockSize = LFO_BLOCK_SIZE;
+
+            // --- outer APF modulation; the inner APF is not modulated
+            OuterAPF::renderModulationBlock(blockSize);
+            for (int i = 0; i < blockSize; i++)
+                output[offset + i] = NestedDelayAPF::processAudioSample(input[offset + i]);
+        }
+    }
+
     /** get parameters: note use of custom structure for passing param data */
     /**
     \return BiquadParameters custom data structure
@@ -121,7 +150,7 @@ public:
     {
         nestedAPFParameters = params;
 
-        DelayAPFParameters outerAPFParameters = DelayAPF::getParameters();
+        DelayAPFParameters outerAPFParameters = OuterAPF::getParameters();
         DelayAPFParameters innerAPFParameters = nestedAPF.getParameters();
 
         // --- outer APF
@@ -133,12 +162,14 @@ public:
         outerAPFParameters.lfoDepth = nestedAPFParameters.lfoDepth;
         outerAPFParameters.lfoRate_Hz = nestedAPFParameters.lfoRate_Hz;
         outerAPFParameters.lfoMaxModulation_mSec = nestedAPFParameters.lfoMaxModulation_mSec;
+        outerAPFParameters.lfoUpdateInterval = nestedAPFParameters.lfoUpdateInterval;
+        outerAPFParameters.interpolate = nestedAPFParameters.interpolate;
 
         // --- inner APF
         innerAPFParameters.apf_g = nestedAPFParameters.innerAPF_g;
         innerAPFParameters.delayTime_mSec = nestedAPFParameters.innerAPFdelayTime_mSec;
 
-        DelayAPF::setParameters(outerAPFParameters);
+        OuterAPF::setParameters(outerAPFParameters);
         nestedAPF.setParameters(innerAPFParameters);
     }
 
@@ -146,13 +177,23 @@ public:
     void createDelayBuffers(double _sampleRate, double delay_mSec, double nestedAPFDelay_mSec)
     {
         // --- base class
-        DelayAPF::createDelayBuffer(_sampleRate, delay_mSec);
+        OuterAPF::createDelayBuffer(_sampleRate, delay_mSec);
 
         // --- then our stuff
         nestedAPF.createDelayBuffer(_sampleRate, nestedAPFDelay_mSec);
     }
 
+    /** createDelayBuffers in memory carved from a DelayArena: outer APF first, then inner */
+    void createDelayBuffers(double _sampleRate, double delay_mSec, double nestedAPFDelay_mSec, DelayArena<T>& arena)
+    {
+        // --- base class
+        OuterAPF::createDelayBuffer(_sampleRate, delay_mSec, arena);
+
+        // --- then our stuff
+        nestedAPF.createDelayBuffer(_sampleRate, nestedAPFDelay_mSec, arena);
+    }
+
 private:
     NestedDelayAPFParameters nestedAPFParameters; ///< object parameters
-    DelayAPF nestedAPF;	///< nested APF object
+    DelayAPF<T, Interpolator> nestedAPF;	///< nested APF object
 };
\ No newline at end of file
@@ -32,6 +32,8 @@ struct NestedDelayAPFParameters
         lfoRate_Hz = params.lfoRate_Hz;
         lfoDepth = params.lfoDepth;
         lfoMaxModulation_mSec = params.lfoMaxModulation_mSec;
+        lfoUpdateInterval = params.lfoUpdateInterval;
+        interpolate = params.interpolate;
 
         return *this;
     }
@@ -47,4 +49,6 @@ struct NestedDelayAPFParameters
     double lfoRate_Hz = 0.0;				///< LFO rate in Hz (if enabled)
     double lfoDepth = 1.0;					///< LFO depth (not in %) (if enabled)
     double lfoMaxModulation_mSec = 0.0;		///< max modulation time if LFO is enabled
+    unsigned int lfoUpdateInterval = 1;		///< evaluate the LFO every N samples, interpolating the delay time in between (1 = every sample)
+    bool interpolate = false;				///< interpolate the modulated read with the object's Interpolator policy
 };
\ No newline at end of file
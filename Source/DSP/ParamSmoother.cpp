@@ -2,6 +2,9 @@
 
 #include "ParamSmoother.h"
 
+// --- closer than this to the target counts as settled
+static const float kSmoothingThreshold = 1.0e-4f;
+
 void ParamSmoother::initializeSmoothing(float smoothingTimeInMs, float samplingRate)
 {
     const float twoPi = juce::MathConstants<float>::twoPi;
@@ -9,10 +12,33 @@ void ParamSmoother::initializeSmoothing(float smoothingTimeInMs, float samplingR
     a = exp(-twoPi / (smoothingTimeInMs * 0.001f * samplingRate));
     b = 1.0f - a;
     outputValue = 0.0f;
+    targetValue = 0.0f;
 }
 
 float ParamSmoother::processSmoothing(float inputValue)
 {
+    targetValue = inputValue;
     outputValue = (inputValue * b) + (outputValue * a);
+    snapToTarget();
+    return outputValue;
+}
+
+// --- same result as calling processSmoothing(inputValue) numSamples times
+float ParamSmoother::processSmoothing(float inputValue, int numSamples)
+{
+    targetValue = inputValue;
+    outputValue = inputValue + (outputValue - inputValue) * std::pow(a, (float)numSamples);
+    snapToTarget();
     return outputValue;
 }
+
+bool ParamSmoother::isSmoothing() const
+{
+    return outputValue != targetValue;
+}
+
+void ParamSmoother::snapToTarget()
+{
+    if (std::abs(outputValue - targetValue) < kSmoothingThreshold)
+        outputValue = targetValue;
+}
@@ -9,9 +9,14 @@ class ParamSmoother
 public:
     void initializeSmoothing(float smoothingTimeInMs, float samplingRate);
     float processSmoothing(float inputValue);
+    float processSmoothing(float inputValue, int numSamples);
+    bool isSmoothing() const;
 
 private:
+    void snapToTarget();
+
     float a;
     float b;
     float outputValue;
+    float targetValue;
 };
@@ -5,13 +5,15 @@
 #include "IAudioSignalProcessor.h"
 #include "ReverbTankParameters.h"
 #include "TwoBandShelvingFilterParameters.h"
-#include "SimpleLPFParameters.h"
 #include "SimpleDelayParameters.h"
-#include "NestedDelayAPFParameters.h"
 #include "SimpleDelay.h"
-#include "SimpleLPF.h"
-#include "NestedDelayAPF.h"
-#include "TwoBandShelvingFilter.h"
+#include "ReverbTankBranches.h"
+#include "ReverbTankBranchesSIMD.h"
+#include "StereoShelvingFilter.h"
+#include "GainStage.h"
+
+// --- upper limit of preDelayTime_mSec: the pre-delay line is sized for this and longer settings are clamped
+const double kReverbTankPreDelayMax_mSec = 150.0;
 
 /**
 \class ReverbTank
@@ -24,46 +26,90 @@ Audio I/O:
 
 Control I/F:
 - Use ReverbTankParameters structure to get/set object params.
+- Template parameter T is the sample type (float or double) of the audio path and delay lines;
+  parameters, coefficient designs and the LFOs always use double.
+- Template parameter Branches is the recirculating branch network: ReverbTankBranches (one branch
+  after the other) or ReverbTankBranchesSIMD (all four branches at once); see ReverbTankSIMD below.
+  Both take the interpolator policy of the modulated APF reads, e.g. ReverbTankBranches<T, HermiteInterpolator>,
+  used when ReverbTankParameters::interpolateModulation is set.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class ReverbTank : public IAudioSignalProcessor
+template <typename T, typename Branches = ReverbTankBranches<T>>
+class ReverbTank : public IAudioSignalProcessor<T>
 {
 public:
-    ReverbTank() {}		/* C-TOR */
+    ReverbTank()
+    {
+        dryGain.reset(parameters.dryLevel_dB);
+        wetGain.reset(parameters.wetLevel_dB);
+    }					/* C-TOR */
     ~ReverbTank() {}	/* D-TOR */
 
     /** reset members to initialized state */
+    /**
+    The delay memory is reserved for MAX_SAMPLE_RATE on the first reset( ), so this only allocates then (or
+    if _sampleRate is higher still); after that a sample rate change re-slices and flushes the same memory.
+    */
     virtual bool reset(double _sampleRate)
     {
         // ---store
         sampleRate = _sampleRate;
 
-        // ---set up preDelay
+        // --- lay out all of the delay lines in one arena, counted at the highest sample rate we reserve for
+        if (_sampleRate > reservedSampleRate)
+        {
+            reservedSampleRate = fmax(_sampleRate, MAX_SAMPLE_RATE);
+
+            delayArena.beginLayout();
+            createDelayBuffers(reservedSampleRate);
+            delayArena.allocate();
+        }
+
+        // --- then carve them for this sample rate
+        delayArena.rewind();
+        createDelayBuffers(_sampleRate);
+
+        // --- then reset; the delay lines keep their arena memory
         preDelay.reset(_sampleRate);
-        preDelay.createDelayBuffer(_sampleRate, 100.0);
+        branches.reset(_sampleRate);
 
-        for (int i = 0; i < NUM_BRANCHES; i++)
-        {
-            branchDelays[i].reset(_sampleRate);
-            branchDelays[i].createDelayBuffer(_sampleRate, 100.0);
+        shelvingFilter.reset(_sampleRate);
 
-            branchNestedAPFs[i].reset(_sampleRate);
-            branchNestedAPFs[i].createDelayBuffers(_sampleRate, 100.0, 100.0);
+        // --- delay lengths in samples changed with the sample rate
+        forceParameterUpdate = true;
 
-            branchLPFs[i].reset(_sampleRate);
-        }
-        for (int i = 0; i < NUM_CHANNELS; i++)
-        {
-            shelvingFilters[i].reset(_sampleRate);
-        }
+        // --- no level ramps pending
+        dryGain.reset(parameters.dryLevel_dB);
+        wetGain.reset(parameters.wetLevel_dB);
 
         return true;
     }
 
+    /** flush the delay lines and filter states and jump to the current output levels; the sample rate and
+        memory are unchanged and nothing is allocated, so this is safe to call from the audio thread */
+    void flush()
+    {
+        // --- nothing to flush before the first reset( )
+        if (reservedSampleRate == 0.0)
+            return;
+
+        preDelay.flush();
+        branches.flush();
+
+        // --- filter states only: the designs and coefficient tables stay as the last reset( ) left them
+        shelvingFilter.flush();
+
+        dryGain.reset(parameters.dryLevel_dB);
+        wetGain.reset(parameters.wetLevel_dB);
+    }
+
+    /** the arena holding the delay lines of the tank */
+    const DelayArena<T>& getDelayArena() { return delayArena; }
+
     /** return true: this object can process frames */
     virtual bool canProcessAudioFrame() { return true; }
 
@@ -72,99 +118,82 @@ public:
     \param xn input
     \return the processed sample
     */
-    virtual double processAudioSample(double xn)
+    virtual T processAudioSample(T xn)
     {
-        float inputs[2] = { 0.0, 0.0 };
-        float outputs[2] = { 0.0, 0.0 };
+        T inputs[2] = { 0.0, 0.0 };
+        T outputs[2] = { 0.0, 0.0 };
         processAudioFrame(inputs, outputs, 1, 1);
         return outputs[0];
     }
 
     /** process stereo reverb tank */
-    virtual bool processAudioFrame(const float* inputFrame,
-        float* outputFrame,
+    virtual bool processAudioFrame(const T* inputFrame,
+        T* outputFrame,
         uint32_t inputChannels,
         uint32_t outputChannels)
     {
-        // --- global feedback from delay in last branch
-        double globFB = branchDelays[NUM_BRANCHES - 1].readDelay();
-
-        // --- feedback value
-        double fb = parameters.kRT * (globFB);
-
         // --- mono-ized input signal
-        double xnL = inputFrame[0];
-        double xnR = inputChannels > 1 ? inputFrame[1] : 0.0;
-        double monoXn = double(1.0 / inputChannels) * xnL + double(1.0 / inputChannels) * xnR;
+        T xnL = inputFrame[0];
+        T xnR = inputChannels > 1 ? inputFrame[1] : (T)0.0;
+        T monoXn = T(1.0 / inputChannels) * xnL + T(1.0 / inputChannels) * xnR;
 
         // --- pre delay output
-        double preDelayOut = preDelay.processAudioSample(monoXn);
+        T preDelayOut = preDelay.processAudioSample(monoXn);
 
-        // --- input to first branch = preDalay + globFB
-        double input = preDelayOut + fb;
-        for (int i = 0; i < NUM_BRANCHES; i++)
-        {
-            double apfOut = branchNestedAPFs[i].processAudioSample(input);
-            double lpfOut = branchLPFs[i].processAudioSample(apfOut);
-            double delayOut = parameters.kRT * branchDelays[i].processAudioSample(lpfOut);
-            input = delayOut + preDelayOut;
-        }
-        // --- gather outputs
-        /*
-        There are 25 prime numbers between 1 and 100.
-        They are 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
-        43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
-
-        we want 16 of them: 23, 29, 31, 37, 41,
-        43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
-        */
-
-        double weight = 0.707;
-
-        double outL = 0.0;
-        outL += weight * branchDelays[0].readDelayAtPercentage(23.0);
-        outL -= weight * branchDelays[1].readDelayAtPercentage(41.0);
-        outL += weight * branchDelays[2].readDelayAtPercentage(59.0);
-        outL -= weight * branchDelays[3].readDelayAtPercentage(73.0);
-
-        double outR = 0.0;
-        outR -= weight * branchDelays[0].readDelayAtPercentage(29.0);
-        outR += weight * branchDelays[1].readDelayAtPercentage(43.0);
-        outR -= weight * branchDelays[2].readDelayAtPercentage(61.0);
-        outR += weight * branchDelays[3].readDelayAtPercentage(79.0);
-
-        if (parameters.density == reverbDensity::kThick)
-        {
-            outL += weight * branchDelays[0].readDelayAtPercentage(31.0);
-            outL -= weight * branchDelays[1].readDelayAtPercentage(47.0);
-            outL += weight * branchDelays[2].readDelayAtPercentage(67.0);
-            outL -= weight * branchDelays[3].readDelayAtPercentage(83.0);
-
-            outR -= weight * branchDelays[0].readDelayAtPercentage(37.0);
-            outR += weight * branchDelays[1].readDelayAtPercentage(53.0);
-            outR -= weight * branchDelays[2].readDelayAtPercentage(71.0);
-            outR += weight * branchDelays[3].readDelayAtPercentage(89.0);
-        }
+        // --- run the tank
+        T outL = 0.0;
+        T outR = 0.0;
+        branches.processAudioSample(preDelayOut, outL, outR);
 
         // ---  filter
-        double tankOutL = shelvingFilters[0].processAudioSample(outL);
-        double tankOutR = shelvingFilters[1].processAudioSample(outR);
+        shelvingFilter.processAudioFrame(outL, outR);
 
         // --- sum with dry
-        double dry = pow(10.0, parameters.dryLevel_dB / 20.0);
-        double wet = pow(10.0, parameters.wetLevel_dB / 20.0);
+        T dry = dryGain.getNextGain();
+        T wet = wetGain.getNextGain();
 
         if (outputChannels == 1)
-            outputFrame[0] = dry * xnL + wet * (0.5 * tankOutL + 0.5 * tankOutR);
+            outputFrame[0] = dry * xnL + wet * ((T)0.5 * outL + (T)0.5 * outR);
         else
         {
-            outputFrame[0] = dry * xnL + wet * tankOutL;
-            outputFrame[1] = dry * xnR + wet * tankOutR;
+            outputFrame[0] = dry * xnL + wet * outL;
+            outputFrame[1] = dry * xnR + wet * outR;
         }
 
         return true;
     }
 
+    /** process a block of mono or stereo audio through the reverb tank */
+    /**
+    \param inputs non-interleaved input channel pointers
+    \param outputs non-interleaved output channel pointers; may be the same buffers as inputs
+    \param numChannels number of channels (1 = mono, 2 = stereo)
+    \param numSamples number of samples in each channel
+    */
+    virtual void processBlock(const T* const* inputs, T* const* outputs, int numChannels, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+
+        // --- the dry and wet gains ramp across the block from where the previous block left off
+        //     so that parameter changes between blocks do not zipper
+        dryGain.startRamp(numSamples);
+        wetGain.startRamp(numSamples);
+
+        // --- likewise the shelving coefficients ramp across the whole block, not just the first chunk
+        shelvingFilter.startCoefficientRamp(numSamples);
+
+        // --- work through the block in chunks that fit our scratch buffers
+        for (int offset = 0; offset < numSamples; offset += TANK_BLOCK_SIZE)
+        {
+            int blockSize = numSamples - offset;
+            if (blockSize > (int)TANK_BLOCK_SIZE)
+                blockSize = TANK_BLOCK_SIZE;
+
+            processTankBlock(inputs, outputs, numChannels, offset, blockSize);
+        }
+    }
+
     /** get parameters: note use of custom structure for passing param data */
     /**
     \return ReverbTankParameters custom data structure
@@ -177,84 +206,131 @@ public:
     */
     void setParameters(const ReverbTankParameters& params)
     {
-        // --- do the updates here, the sub-components will only update themselves if
-        //     their parameters changed, so we let those object handle that chore
-        TwoBandShelvingFilterParameters filterParams = shelvingFilters[0].getParameters();
-        filterParams.highShelf_fc = params.highShelf_fc;
-        filterParams.highShelfBoostCut_dB = params.highShelfBoostCut_dB;
-        filterParams.lowShelf_fc = params.lowShelf_fc;
-        filterParams.lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
-
-        // --- copy to both channels
-        shelvingFilters[0].setParameters(filterParams);
-        shelvingFilters[1].setParameters(filterParams);
-
-        SimpleLPFParameters  lpfParams = branchLPFs[0].getParameters();
-        lpfParams.g = params.lpf_g;
-
-        for (int i = 0; i < NUM_BRANCHES; i++)
+        // --- this is called at control rate, so only push the groups of settings that actually
+        //     changed; after a reset( ) everything is pushed once since delay lengths in samples
+        //     depend on the sample rate
+        if (forceParameterUpdate ||
+            params.lowShelf_fc != parameters.lowShelf_fc ||
+            params.lowShelfBoostCut_dB != parameters.lowShelfBoostCut_dB ||
+            params.highShelf_fc != parameters.highShelf_fc ||
+            params.highShelfBoostCut_dB != parameters.highShelfBoostCut_dB)
         {
-            branchLPFs[i].setParameters(lpfParams);
+            TwoBandShelvingFilterParameters filterParams = shelvingFilter.getParameters();
+            filterParams.highShelf_fc = params.highShelf_fc;
+            filterParams.highShelfBoostCut_dB = params.highShelfBoostCut_dB;
+            filterParams.lowShelf_fc = params.lowShelf_fc;
+            filterParams.lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
+
+            // --- designed once, both channels share the coefficients
+            shelvingFilter.setParameters(filterParams);
         }
 
         // --- update pre delay
-        SimpleDelayParameters delayParams = preDelay.getParameters();
-        delayParams.delayTime_mSec = params.preDelayTime_mSec;
-        preDelay.setParameters(delayParams);
+        if (forceParameterUpdate || params.preDelayTime_mSec != parameters.preDelayTime_mSec)
+        {
+            SimpleDelayParameters delayParams = preDelay.getParameters();
+            delayParams.delayTime_mSec = params.preDelayTime_mSec;
+            preDelay.setParameters(delayParams);
+        }
+
+        // --- the branch network checks its own settings for changes
+        branches.setParameters(params);
+
+        // --- output levels: dB to linear happens here, once per control block
+        dryGain.setGain_dB(params.dryLevel_dB);
+        wetGain.setGain_dB(params.wetLevel_dB);
+
+        // --- save our copy
+        parameters = params;
+        forceParameterUpdate = false;
+    }
 
-        // --- set apf and delay parameters
-        int m = 0;
-        NestedDelayAPFParameters apfParams = branchNestedAPFs[0].getParameters();
-        delayParams = branchDelays[0].getParameters();
+    /** design the shelving filters from precomputed coefficient tables, so automating the shelf gains
+        costs no trig calls; takes effect at the next reset( ), which is where the tables are fetched (flush( )
+        leaves them alone) */
+    /**
+    \param use true to use the tables
+    */
+    void setUseCoefficientTables(bool use)
+    {
+        shelvingFilter.setUseCoefficientTables(use);
+    }
 
-        // --- global max Delay times
-        double globalAPFMaxDelay = (parameters.apfDelayWeight_Pct / 100.0) * parameters.apfDelayMax_mSec;
-        double globalFixedMaxDelay = (parameters.fixeDelayWeight_Pct / 100.0) * parameters.fixeDelayMax_mSec;
+private:
+    /** create (or count, in the arena's layout pass) the delay lines in processing order: pre-delay, then
+        each branch's APFs and delay */
+    void createDelayBuffers(double _sampleRate)
+    {
+        preDelay.createDelayBuffer(_sampleRate, kReverbTankPreDelayMax_mSec, delayArena, getReverbTankBlockHeadroom_mSec(_sampleRate));
+        branches.createDelayBuffers(_sampleRate, delayArena);
+    }
 
-        // --- lfo
-        apfParams.enableLFO = true;
-        apfParams.lfoMaxModulation_mSec = 0.3;
-        apfParams.lfoDepth = 1.0;
+    /** process one chunk of at most TANK_BLOCK_SIZE samples, starting at offset in the I/O buffers */
+    void processTankBlock(const T* const* inputs, T* const* outputs, int numChannels, int offset, int blockSize)
+    {
+        const T* inL = inputs[0] + offset;
+        const T* inR = numChannels > 1 ? inputs[1] + offset : nullptr;
 
-        for (int i = 0; i < NUM_BRANCHES; i++)
+        // --- mono-ized input signal
+        T monoGain = T(1.0 / numChannels);
+        for (int n = 0; n < blockSize; n++)
         {
-            // --- setup APFs
-            apfParams.outerAPFdelayTime_mSec = globalAPFMaxDelay * apfDelayWeight[m++];
-            apfParams.innerAPFdelayTime_mSec = globalAPFMaxDelay * apfDelayWeight[m++];
-            apfParams.innerAPF_g = -0.5;
-            apfParams.outerAPF_g = 0.5;
-            if (i == 0)
-                apfParams.lfoRate_Hz = 0.15;
-            else if (i == 1)
-                apfParams.lfoRate_Hz = 0.33;
-            else if (i == 2)
-                apfParams.lfoRate_Hz = 0.57;
-            else if (i == 3)
-                apfParams.lfoRate_Hz = 0.73;
-
-            branchNestedAPFs[i].setParameters(apfParams);
-
-            // --- fixedDelayWeight
-            delayParams.delayTime_mSec = globalFixedMaxDelay * fixedDelayWeight[i];
-            branchDelays[i].setParameters(delayParams);
+            T xnR = inR ? inR[n] : (T)0.0;
+            monoBuffer[n] = monoGain * inL[n] + monoGain * xnR;
         }
 
-        // --- save our copy
-        parameters = params;
+        // --- pre delay is feed-forward so it can run on the whole chunk
+        preDelay.processBlock(monoBuffer, monoBuffer, blockSize);
+
+        // --- the recirculating branches
+        branches.processBlock(monoBuffer, tankBuffer[0], tankBuffer[1], blockSize);
+
+        // ---  filter, both channels and both shelves in one pass
+        shelvingFilter.processBlock(tankBuffer[0], tankBuffer[1], blockSize);
+
+        // --- sum with dry
+        if (numChannels == 1)
+        {
+            for (int n = 0; n < blockSize; n++)
+                tankBuffer[0][n] = (T)0.5 * tankBuffer[0][n] + (T)0.5 * tankBuffer[1][n];
+
+            dryGain.multiply(inL, outputs[0] + offset, blockSize);
+            wetGain.multiplyAdd(tankBuffer[0], outputs[0] + offset, blockSize);
+        }
+        else
+        {
+            for (int ch = 0; ch < NUM_CHANNELS; ch++)
+            {
+                dryGain.multiply(inputs[ch] + offset, outputs[ch] + offset, blockSize);
+                wetGain.multiplyAdd(tankBuffer[ch], outputs[ch] + offset, blockSize);
+            }
+        }
+
+        dryGain.advance(blockSize);
+        wetGain.advance(blockSize);
     }
 
-private:
     ReverbTankParameters parameters;				///< object parameters
+    DelayArena<T> delayArena;						///< memory for all of the delay lines
 
-    SimpleDelay  preDelay;							///< pre delay object
-    SimpleDelay  branchDelays[NUM_BRANCHES];		///< branch delay objects
-    NestedDelayAPF branchNestedAPFs[NUM_BRANCHES];	///< nested APFs for each branch
-    SimpleLPF  branchLPFs[NUM_BRANCHES];			///< LPFs in each branch
+    SimpleDelay<T, LinearInterpolator, MirroredCircularBuffer> preDelay;	///< pre delay object (contiguous block reads)
+    Branches branches;								///< the recirculating branch network
 
-    TwoBandShelvingFilter shelvingFilters[NUM_CHANNELS]; ///< shelving filters 0 = left; 1 = right
+    StereoShelvingFilter<T> shelvingFilter;			///< shelving filters for the left and right outputs
 
-    // --- weighting values to make various and low-correlated APF delay values easily
-    double apfDelayWeight[NUM_BRANCHES * 2] = { 0.317, 0.873, 0.477, 0.291, 0.993, 0.757, 0.179, 0.575 };///< weighting values to make various and low-correlated APF delay values easily
-    double fixedDelayWeight[NUM_BRANCHES] = { 1.0, 0.873, 0.707, 0.667 };	///< weighting values to make various and fixed delay values easily
     double sampleRate = 0.0;	///< current sample rate
-};
\ No newline at end of file
+    double reservedSampleRate = 0.0;	///< highest sample rate the delay arena is laid out for
+    bool forceParameterUpdate = true;	///< push all parameters to the sub-objects on the next setParameters( )
+
+    // --- block processing support
+    T monoBuffer[TANK_BLOCK_SIZE] = { 0.0 };						///< mono-ized input, then pre delay output
+    T tankBuffer[NUM_CHANNELS][TANK_BLOCK_SIZE] = { { 0.0 } };		///< tank outputs before the dry/wet mix
+
+    // --- output levels
+    GainStage<T> dryGain;	///< dry level, converted to linear at control rate and ramped per sample
+    GainStage<T> wetGain;	///< wet level, converted to linear at control rate and ramped per sample
+};
+
+/** the reverb tank with its four branches processed in SIMD lanes */
+template <typename T>
+using ReverbTankSIMD = ReverbTank<T, ReverbTankBranchesSIMD<T>>;
\ No newline at end of file
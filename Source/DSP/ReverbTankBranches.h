@@ -0,0 +1,392 @@
+// ReverbTankBranches.h
+
+#pragma once
+
+#include "ReverbTankParameters.h"
+#include "SimpleLPFParameters.h"
+#include "SimpleDelayParameters.h"
+#include "NestedDelayAPFParameters.h"
+#include "SimpleDelay.h"
+#include "SimpleLPF.h"
+#include "NestedDelayAPF.h"
+
+// --- weighting values to make various and low-correlated APF delay values easily
+const double kReverbTankAPFDelayWeight[NUM_BRANCHES * 2] = { 0.317, 0.873, 0.477, 0.291, 0.993, 0.757, 0.179, 0.575 };
+
+// --- weighting values to make various and fixed delay values easily
+const double kReverbTankFixedDelayWeight[NUM_BRANCHES] = { 1.0, 0.873, 0.707, 0.667 };
+
+// --- LFO rates for the modulated APF in each branch
+const double kReverbTankLFORate_Hz[NUM_BRANCHES] = { 0.15, 0.33, 0.57, 0.73 };
+
+// --- the sub-Hz LFOs only need to be evaluated at control rate: once every N samples
+const unsigned int kReverbTankLFOUpdateInterval = 16;
+
+// --- upper limits of apfDelayMax_mSec and fixeDelayMax_mSec (with the weightings at 100%): the delay lines
+//     are sized for these and longer settings are clamped
+const double kReverbTankAPFDelayMax_mSec = 33.0;
+const double kReverbTankFixedDelayMax_mSec = 81.0;
+
+/**
+@getReverbTankBlockHeadroom_mSec
+\ingroup FX-Functions
+
+@brief calculates the extra length for delay lines that are read a TANK_BLOCK_SIZE block after it was written
+
+\param sampleRate - the sample rate
+\return the extra length in mSec
+*/
+inline double getReverbTankBlockHeadroom_mSec(double sampleRate)
+{
+    return TANK_BLOCK_SIZE * 1000.0 / sampleRate;
+}
+
+/**
+@getReverbTankAPFParameters
+\ingroup FX-Functions
+
+@brief calculates the nested APF settings for one branch of the reverb tank from the tweaker variables
+
+\param params - the reverb tank parameters
+\param branch - the branch index [0, NUM_BRANCHES - 1]
+\return the nested APF parameters for that branch
+*/
+inline NestedDelayAPFParameters getReverbTankAPFParameters(const ReverbTankParameters& params, int branch)
+{
+    NestedDelayAPFParameters apfParams;
+
+    // --- global max Delay times
+    double globalAPFMaxDelay = (params.apfDelayWeight_Pct / 100.0) * params.apfDelayMax_mSec;
+
+    // --- lfo
+    apfParams.enableLFO = true;
+    apfParams.lfoMaxModulation_mSec = 0.3;
+    apfParams.lfoDepth = 1.0;
+    apfParams.lfoRate_Hz = kReverbTankLFORate_Hz[branch];
+    apfParams.lfoUpdateInterval = kReverbTankLFOUpdateInterval;
+    apfParams.interpolate = params.interpolateModulation;
+
+    // --- setup APFs
+    apfParams.outerAPFdelayTime_mSec = globalAPFMaxDelay * kReverbTankAPFDelayWeight[2 * branch];
+    apfParams.innerAPFdelayTime_mSec = globalAPFMaxDelay * kReverbTankAPFDelayWeight[2 * branch + 1];
+    apfParams.innerAPF_g = -0.5;
+    apfParams.outerAPF_g = 0.5;
+
+    return apfParams;
+}
+
+/**
+@getReverbTankFixedDelay_mSec
+\ingroup FX-Functions
+
+@brief calculates the fixed delay time for one branch of the reverb tank from the tweaker variables
+
+\param params - the reverb tank parameters
+\param branch - the branch index [0, NUM_BRANCHES - 1]
+\return the delay time in mSec
+*/
+inline double getReverbTankFixedDelay_mSec(const ReverbTankParameters& params, int branch)
+{
+    double globalFixedMaxDelay = (params.fixeDelayWeight_Pct / 100.0) * params.fixeDelayMax_mSec;
+    return globalFixedMaxDelay * kReverbTankFixedDelayWeight[branch];
+}
+
+// --- output taps on each branch delay: left and right for the thin density, then left and right added for thick
+const unsigned int NUM_TAPS_PER_BRANCH = 4;
+
+/*
+There are 25 prime numbers between 1 and 100.
+They are 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
+43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
+
+we want 16 of them: 23, 29, 31, 37, 41,
+43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, and 97
+*/
+const double kReverbTankOutputTap_Pct[NUM_BRANCHES][NUM_TAPS_PER_BRANCH] = { { 23.0, 29.0, 31.0, 37.0 },
+                                                                             { 41.0, 43.0, 47.0, 53.0 },
+                                                                             { 59.0, 61.0, 67.0, 71.0 },
+                                                                             { 73.0, 79.0, 83.0, 89.0 } };
+
+/**
+@makeReverbTankOutputTaps
+\ingroup FX-Functions
+
+@brief builds the output tap table for the branch delays of the reverb tank; the taps alternate in sign
+from branch to branch and between left and right. Call this when the branch delay times change, not per sample.
+
+\param branchDelays - the NUM_BRANCHES branch delay lines, with their delay times set
+\param taps - the tap table to fill, [branch][left thin, right thin, left thick, right thick]
+*/
+template <typename T>
+inline void makeReverbTankOutputTaps(SimpleDelay<T>* branchDelays, DelayTap<T> taps[NUM_BRANCHES][NUM_TAPS_PER_BRANCH])
+{
+    T weight = (T)0.707;
+
+    for (int i = 0; i < NUM_BRANCHES; i++)
+    {
+        for (int k = 0; k < NUM_TAPS_PER_BRANCH; k++)
+        {
+            T gain = (i + k) % 2 == 0 ? weight : -weight;
+            taps[i][k] = branchDelays[i].getTapAtPercentage(kReverbTankOutputTap_Pct[i][k], gain);
+        }
+    }
+}
+
+/**
+@readReverbTankOutputs
+\ingroup FX-Functions
+
+@brief gathers the left and right outputs of the reverb tank from the taps on the branch delays
+
+\param branchDelays - the NUM_BRANCHES branch delay lines
+\param taps - the tap table from makeReverbTankOutputTaps( )
+\param density - thick density adds a second set of taps
+\param outL - left output
+\param outR - right output
+*/
+template <typename T>
+inline void readReverbTankOutputs(SimpleDelay<T>* branchDelays, const DelayTap<T> taps[NUM_BRANCHES][NUM_TAPS_PER_BRANCH],
+    reverbDensity density, T& outL, T& outR)
+{
+    int numTaps = density == reverbDensity::kThick ? NUM_TAPS_PER_BRANCH : NUM_TAPS_PER_BRANCH / 2;
+    T tapOutputs[NUM_BRANCHES][NUM_TAPS_PER_BRANCH];
+
+    for (int i = 0; i < NUM_BRANCHES; i++)
+        branchDelays[i].readTaps(taps[i], numTaps, tapOutputs[i]);
+
+    // --- sum thin taps on every branch, then thick taps
+    outL = 0.0;
+    outR = 0.0;
+    for (int k = 0; k < numTaps; k += 2)
+    {
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            outL += tapOutputs[i][k];
+            outR += tapOutputs[i][k + 1];
+        }
+    }
+}
+
+/**
+@mixReverbTankOutputsBlock
+\ingroup FX-Functions
+
+@brief gathers the left and right outputs of the reverb tank for the block that was just written to the
+branch delays; the sums are formed in the same order as readReverbTankOutputs( )
+
+\param branchDelays - the NUM_BRANCHES branch delay lines
+\param taps - the tap table from makeReverbTankOutputTaps( )
+\param density - thick density adds a second set of taps
+\param outL - left outputs
+\param outR - right outputs
+\param numSamples - number of samples in the block
+*/
+template <typename T>
+inline void mixReverbTankOutputsBlock(SimpleDelay<T>* branchDelays, const DelayTap<T> taps[NUM_BRANCHES][NUM_TAPS_PER_BRANCH],
+    reverbDensity density, T* outL, T* outR, int numSamples)
+{
+    int numTaps = density == reverbDensity::kThick ? NUM_TAPS_PER_BRANCH : NUM_TAPS_PER_BRANCH / 2;
+
+    for (int n = 0; n < numSamples; n++)
+    {
+        outL[n] = 0.0;
+        outR[n] = 0.0;
+    }
+
+    for (int k = 0; k < numTaps; k += 2)
+    {
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            branchDelays[i].mixTapsBlock(&taps[i][k], 1, outL, numSamples);
+            branchDelays[i].mixTapsBlock(&taps[i][k + 1], 1, outR, numSamples);
+        }
+    }
+}
+
+/**
+\class ReverbTankBranches
+\ingroup FX-Objects
+\brief
+The ReverbTankBranches object implements the recirculating part of the reverb tank: NUM_BRANCHES branches of
+nested APF, LPF and fixed delay in a loop, with the pre-delayed input added to each branch. The branches are
+processed one after the other, in the same way as the FX book.
+
+NOTE: this is NOT an IAudioSignalProcessor; it is the branch network policy of ReverbTank (see also
+ReverbTankBranchesSIMD) and processes mono input to stereo output.
+
+Control I/F:
+- Use ReverbTankParameters structure to set object params; only the density, kRT, lpf_g, the
+  delay tweaker variables and interpolateModulation are used.
+- Template parameter Interpolator is the fractional delay interpolator policy of the modulated APF reads
+  (see DelayInterpolators.h); it is used when ReverbTankParameters::interpolateModulation is set.
+*/
+template <typename T, template <typename> class Interpolator = LinearInterpolator>
+class ReverbTankBranches
+{
+public:
+    ReverbTankBranches() {}		/* C-TOR */
+    ~ReverbTankBranches() {}	/* D-TOR */
+
+    /** create the delay lines in memory carved from a DelayArena, in processing order; call before reset( ) */
+    /**
+    Each line is sized for the longest delay the tweaker variables can give it; the LFOs modulate down
+    from the APF delay times, so they need no extra room. The branch delays are also read for the output
+    taps a block at a time.
+    */
+    void createDelayBuffers(double _sampleRate, DelayArena<T>& arena)
+    {
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            branchNestedAPFs[i].createDelayBuffers(_sampleRate,
+                kReverbTankAPFDelayMax_mSec * kReverbTankAPFDelayWeight[2 * i],
+                kReverbTankAPFDelayMax_mSec * kReverbTankAPFDelayWeight[2 * i + 1], arena);
+            branchDelays[i].createDelayBuffer(_sampleRate,
+                kReverbTankFixedDelayMax_mSec * kReverbTankFixedDelayWeight[i], arena, getReverbTankBlockHeadroom_mSec(_sampleRate));
+        }
+    }
+
+    /** reset members to initialized state */
+    bool reset(double _sampleRate)
+    {
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            branchDelays[i].reset(_sampleRate);
+            branchNestedAPFs[i].reset(_sampleRate);
+            branchLPFs[i].reset(_sampleRate);
+        }
+
+        // --- delay lengths in samples changed with the sample rate
+        forceParameterUpdate = true;
+        return true;
+    }
+
+    /** flush the delay lines and filter states; nothing is allocated */
+    void flush()
+    {
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            branchDelays[i].flush();
+            branchNestedAPFs[i].flush();
+            branchLPFs[i].reset(0.0); // sample rate is not used
+        }
+    }
+
+    /** set parameters: only the groups of settings that changed are pushed to the sub-objects */
+    /**
+    \param ReverbTankParameters custom data structure
+    */
+    void setParameters(const ReverbTankParameters& params)
+    {
+        if (forceParameterUpdate || params.lpf_g != parameters.lpf_g)
+        {
+            SimpleLPFParameters  lpfParams = branchLPFs[0].getParameters();
+            lpfParams.g = params.lpf_g;
+
+            for (int i = 0; i < NUM_BRANCHES; i++)
+            {
+                branchLPFs[i].setParameters(lpfParams);
+            }
+        }
+
+        // --- set apf and delay parameters; these only depend on the tweaker variables
+        if (forceParameterUpdate ||
+            params.apfDelayMax_mSec != parameters.apfDelayMax_mSec ||
+            params.apfDelayWeight_Pct != parameters.apfDelayWeight_Pct ||
+            params.fixeDelayMax_mSec != parameters.fixeDelayMax_mSec ||
+            params.fixeDelayWeight_Pct != parameters.fixeDelayWeight_Pct ||
+            params.interpolateModulation != parameters.interpolateModulation)
+        {
+            SimpleDelayParameters delayParams = branchDelays[0].getParameters();
+
+            for (int i = 0; i < NUM_BRANCHES; i++)
+            {
+                branchNestedAPFs[i].setParameters(getReverbTankAPFParameters(params, i));
+
+                // --- fixedDelayWeight
+                delayParams.delayTime_mSec = getReverbTankFixedDelay_mSec(params, i);
+                branchDelays[i].setParameters(delayParams);
+            }
+        }
+
+        // --- the output taps only move with the fixed delays (or the sample rate, which forces an update)
+        if (forceParameterUpdate ||
+            params.fixeDelayMax_mSec != parameters.fixeDelayMax_mSec ||
+            params.fixeDelayWeight_Pct != parameters.fixeDelayWeight_Pct)
+        {
+            makeReverbTankOutputTaps(branchDelays, outputTaps);
+        }
+
+        // --- save our copy
+        parameters = params;
+        forceParameterUpdate = false;
+    }
+
+    /** run one (pre-delayed) sample through the recirculating branches and gather the output taps */
+    inline void processAudioSample(T preDelayOut, T& outL, T& outR)
+    {
+        processBranches(preDelayOut);
+
+        // --- gather outputs
+        readReverbTankOutputs(branchDelays, outputTaps, parameters.density, outL, outR);
+    }
+
+    /** process a block of (pre-delayed) samples; the LFOs are rendered a chunk at a time and the branches
+        still run sample by sample, the output taps are then read for the whole block */
+    /**
+    \param input pre-delayed mono input
+    \param outL left output
+    \param outR right output
+    \param numSamples number of samples to process
+    */
+    void processBlock(const T* input, T* outL, T* outR, int numSamples)
+    {
+        for (int offset = 0; offset < numSamples; offset += LFO_BLOCK_SIZE)
+        {
+            int blockSize = numSamples - offset;
+            if (blockSize > (int)LFO_BLOCK_SIZE)
+                blockSize = LFO_BLOCK_SIZE;
+
+            // --- render the APF modulation for the chunk up front
+            for (int i = 0; i < NUM_BRANCHES; i++)
+                branchNestedAPFs[i].renderModulationBlock(blockSize);
+
+            for (int n = 0; n < blockSize; n++)
+                processBranches(input[offset + n]);
+        }
+
+        // --- gather outputs
+        mixReverbTankOutputsBlock(branchDelays, outputTaps, parameters.density, outL, outR, numSamples);
+    }
+
+private:
+    /** run one (pre-delayed) sample through the recirculating branches */
+    inline void processBranches(T preDelayOut)
+    {
+        T kRT = (T)parameters.kRT;
+
+        // --- global feedback from delay in last branch
+        T globFB = branchDelays[NUM_BRANCHES - 1].readDelay();
+
+        // --- feedback value
+        T fb = kRT * (globFB);
+
+        // --- input to first branch = preDalay + globFB
+        T input = preDelayOut + fb;
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            T apfOut = branchNestedAPFs[i].processAudioSample(input);
+            T lpfOut = branchLPFs[i].processAudioSample(apfOut);
+            T delayOut = kRT * branchDelays[i].processAudioSample(lpfOut);
+            input = delayOut + preDelayOut;
+        }
+    }
+
+    ReverbTankParameters parameters;				///< object parameters
+
+    SimpleDelay<T>  branchDelays[NUM_BRANCHES];		///< branch delay objects
+    NestedDelayAPF<T, Interpolator> branchNestedAPFs[NUM_BRANCHES];	///< nested APFs for each branch
+    SimpleLPF<T>  branchLPFs[NUM_BRANCHES];			///< LPFs in each branch
+    DelayTap<T> outputTaps[NUM_BRANCHES][NUM_TAPS_PER_BRANCH];	///< output tap table, rebuilt when the fixed delays change
+
+    bool forceParameterUpdate = true;	///< push all parameters to the sub-objects on the next setParameters( )
+};
\ No newline at end of file
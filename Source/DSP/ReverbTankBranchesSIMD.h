@@ -0,0 +1,394 @@
+// ReverbTankBranchesSIMD.h
+
+#pragma once
+
+#include "ReverbTankBranches.h"
+#include "SIMDVector4.h"
+#include "LFO.h"
+
+/**
+\class ReverbTankBranchesSIMD
+\ingroup FX-Objects
+\brief
+The ReverbTankBranchesSIMD object implements the same recirculating branch network as ReverbTankBranches, but
+runs the four branches side by side in SIMD lanes (structure-of-arrays): lane i holds branch i's APF gains,
+LPF coefficient and LPF state.
+
+This works because every branch only sees the *delayed* output of the branch before it: each sample, all of
+the delay lines are read first (scalar gathers, as they have different lengths), the APF and LPF math for
+all four branches is done with SIMDVector4, then the delay lines are written (scalar scatters). The lane math
+rounds exactly like the scalar objects, so the output matches ReverbTankBranches.
+
+NOTE: this is NOT an IAudioSignalProcessor; it is the branch network policy of ReverbTank and processes
+mono input to stereo output. A branch delay of exactly 0 mSec (only possible with the delay tweaker
+variables at 0) acts as a one sample delay here, since a delay-free branch would make the branches
+depend on each other within the sample.
+
+Control I/F:
+- Use ReverbTankParameters structure to set object params; only the density, kRT, lpf_g, the
+  delay tweaker variables and interpolateModulation are used.
+- Template parameter Interpolator is the fractional delay interpolator policy of the modulated outer APF
+  reads, as in ReverbTankBranches.
+*/
+template <typename T, template <typename> class Interpolator = LinearInterpolator>
+class ReverbTankBranchesSIMD
+{
+    static_assert(NUM_BRANCHES == 4, "ReverbTankBranchesSIMD runs one branch per SIMDVector4 lane");
+
+public:
+    ReverbTankBranchesSIMD() {}		/* C-TOR */
+    ~ReverbTankBranchesSIMD() {}	/* D-TOR */
+
+    /** create the delay lines in memory carved from a DelayArena, in processing order; call before reset( ) */
+    /**
+    The lines are sized as in ReverbTankBranches::createDelayBuffers( )
+    */
+    void createDelayBuffers(double _sampleRate, DelayArena<T>& arena)
+    {
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            outerAPFDelays[i].createDelayBuffer(_sampleRate, kReverbTankAPFDelayMax_mSec * kReverbTankAPFDelayWeight[2 * i], arena);
+            innerAPFDelays[i].createDelayBuffer(_sampleRate, kReverbTankAPFDelayMax_mSec * kReverbTankAPFDelayWeight[2 * i + 1], arena);
+            branchDelays[i].createDelayBuffer(_sampleRate,
+                kReverbTankFixedDelayMax_mSec * kReverbTankFixedDelayWeight[i], arena, getReverbTankBlockHeadroom_mSec(_sampleRate));
+        }
+    }
+
+    /** reset members to initialized state */
+    bool reset(double _sampleRate)
+    {
+        sampleRate = _sampleRate;
+
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            branchDelays[i].reset(_sampleRate);
+            outerAPFDelays[i].reset(_sampleRate);
+            innerAPFDelays[i].reset(_sampleRate);
+
+            modLFOs[i].reset(_sampleRate);
+        }
+
+        clearState();
+
+        // --- delay lengths in samples changed with the sample rate
+        forceParameterUpdate = true;
+        return true;
+    }
+
+    /** flush the delay lines and the LPF and modulation states (the LFOs restart); nothing is allocated */
+    void flush()
+    {
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            branchDelays[i].flush();
+            outerAPFDelays[i].flush();
+            innerAPFDelays[i].flush();
+
+            modLFOs[i].reset(sampleRate);
+        }
+
+        clearState();
+    }
+
+    /** set parameters: only the groups of settings that changed are recalculated */
+    /**
+    \param ReverbTankParameters custom data structure
+    */
+    void setParameters(const ReverbTankParameters& params)
+    {
+        if (forceParameterUpdate || params.lpf_g != parameters.lpf_g)
+        {
+            for (int i = 0; i < NUM_BRANCHES; i++)
+            {
+                lpf_g[i] = (T)params.lpf_g;
+                lpf_oneMinusG[i] = (T)1.0 - lpf_g[i];
+            }
+        }
+
+        // --- set apf and delay parameters; these only depend on the tweaker variables
+        if (forceParameterUpdate ||
+            params.apfDelayMax_mSec != parameters.apfDelayMax_mSec ||
+            params.apfDelayWeight_Pct != parameters.apfDelayWeight_Pct ||
+            params.fixeDelayMax_mSec != parameters.fixeDelayMax_mSec ||
+            params.fixeDelayWeight_Pct != parameters.fixeDelayWeight_Pct ||
+            params.interpolateModulation != parameters.interpolateModulation)
+        {
+            anyAPFBypassed = false;
+            for (int i = 0; i < NUM_BRANCHES; i++)
+            {
+                NestedDelayAPFParameters apfParams = getReverbTankAPFParameters(params, i);
+                if (apfParams.lfoUpdateInterval != apfParameters[i].lfoUpdateInterval)
+                    lfoUpdateCounter[i] = 0;
+
+                apfParameters[i] = apfParams;
+
+                SimpleDelayParameters delayParams = outerAPFDelays[i].getParameters();
+                delayParams.delayTime_mSec = apfParameters[i].outerAPFdelayTime_mSec;
+                delayParams.interpolate = apfParameters[i].interpolate;
+                outerAPFDelays[i].setParameters(delayParams);
+
+                // --- modulate down from the delay time the line accepted
+                apfParameters[i].outerAPFdelayTime_mSec = outerAPFDelays[i].getParameters().delayTime_mSec;
+
+                delayParams = innerAPFDelays[i].getParameters();
+                delayParams.delayTime_mSec = apfParameters[i].innerAPFdelayTime_mSec;
+                innerAPFDelays[i].setParameters(delayParams);
+
+                delayParams = branchDelays[i].getParameters();
+                delayParams.delayTime_mSec = getReverbTankFixedDelay_mSec(params, i);
+                branchDelays[i].setParameters(delayParams);
+
+                outerAPF_g[i] = (T)apfParameters[i].outerAPF_g;
+                outerAPF_negG[i] = -outerAPF_g[i];
+                innerAPF_g[i] = (T)apfParameters[i].innerAPF_g;
+                innerAPF_negG[i] = -innerAPF_g[i];
+
+                // --- a zero length APF passes its input straight through
+                outerAPFBypassed[i] = outerAPFDelays[i].getParameters().delay_Samples == 0;
+                innerAPFBypassed[i] = innerAPFDelays[i].getParameters().delay_Samples == 0;
+                anyAPFBypassed = anyAPFBypassed || outerAPFBypassed[i] || innerAPFBypassed[i];
+            }
+        }
+
+        // --- the output taps only move with the fixed delays (or the sample rate, which forces an update)
+        if (forceParameterUpdate ||
+            params.fixeDelayMax_mSec != parameters.fixeDelayMax_mSec ||
+            params.fixeDelayWeight_Pct != parameters.fixeDelayWeight_Pct)
+        {
+            makeReverbTankOutputTaps(branchDelays, outputTaps);
+        }
+
+        // --- save our copy
+        parameters = params;
+        forceParameterUpdate = false;
+    }
+
+    /** run one (pre-delayed) sample through the recirculating branches and gather the output taps */
+    void processAudioSample(T preDelayOut, T& outL, T& outR)
+    {
+        processBlock(&preDelayOut, &outL, &outR, 1);
+    }
+
+    /** process a block of (pre-delayed) samples; the lane coefficients and LPF states stay in registers */
+    /**
+    \param input pre-delayed mono input
+    \param outL left output
+    \param outR right output
+    \param numSamples number of samples to process
+    */
+    void processBlock(const T* input, T* outL, T* outR, int numSamples)
+    {
+        typedef SIMDVector4<T> Lanes;
+
+        const Lanes kRT((T)parameters.kRT);
+        const Lanes outerG = Lanes::load(outerAPF_g);
+        const Lanes outerNegG = Lanes::load(outerAPF_negG);
+        const Lanes innerG = Lanes::load(innerAPF_g);
+        const Lanes innerNegG = Lanes::load(innerAPF_negG);
+        const Lanes lpfG = Lanes::load(lpf_g);
+        const Lanes lpfOneMinusG = Lanes::load(lpf_oneMinusG);
+        Lanes lpfZ1 = Lanes::load(lpfState);
+
+        // --- lane scratch for the gathers and scatters
+        T feedback[NUM_BRANCHES], outerWnD[NUM_BRANCHES], innerWnD[NUM_BRANCHES];
+        T branchIn[NUM_BRANCHES], outerWn[NUM_BRANCHES], innerWn[NUM_BRANCHES];
+        T innerYn[NUM_BRANCHES], apfOut[NUM_BRANCHES], lpfOut[NUM_BRANCHES];
+
+        for (int n = 0; n < numSamples; n++)
+        {
+            // --- the APF modulation is rendered a chunk at a time
+            if (n % LFO_BLOCK_SIZE == 0)
+                renderModulationBlock(numSamples - n < (int)LFO_BLOCK_SIZE ? numSamples - n : LFO_BLOCK_SIZE);
+
+            // --- 1) gather: read every delay line before any of them is written
+            for (int i = 0; i < NUM_BRANCHES; i++)
+            {
+                // --- branch i is fed by the previous branch's delay; branch 0 by the last one (global feedback)
+                feedback[i] = branchDelays[(i + NUM_BRANCHES - 1) % NUM_BRANCHES].readDelay();
+                outerWnD[i] = outerAPFBypassed[i] ? (T)0.0 : readOuterAPFDelay(i);
+                innerWnD[i] = innerAPFDelays[i].readDelay();
+            }
+
+            // --- 2) the four branches in parallel
+            //
+            // --- input to each branch = preDelay + kRT * previous branch delay
+            Lanes xn = Lanes(input[n]) + kRT * Lanes::load(feedback);
+
+            // --- outer APF: w(n) = x(n) + gw(n-D)
+            Lanes wnD = Lanes::load(outerWnD);
+            Lanes wn = xn + outerG * wnD;
+
+            // --- inner APF processes w(n)
+            Lanes innerD = Lanes::load(innerWnD);
+            Lanes innerW = wn + innerG * innerD;
+            Lanes innerY = (innerNegG * innerW + innerD).flushUnderflow();
+
+            // --- outer APF: y(n) = -gw(n) + w(n-D)
+            Lanes yn = (outerNegG * wn + wnD).flushUnderflow();
+
+            wn.store(outerWn);
+            innerW.store(innerWn);
+            innerY.store(innerYn);
+
+            if (anyAPFBypassed)
+            {
+                yn.store(apfOut);
+                xn.store(branchIn);
+                for (int i = 0; i < NUM_BRANCHES; i++)
+                {
+                    if (outerAPFBypassed[i]) apfOut[i] = branchIn[i];
+                    if (innerAPFBypassed[i]) innerYn[i] = outerWn[i];
+                }
+                yn = Lanes::load(apfOut);
+            }
+
+            // --- branch LPFs
+            lpfZ1 = lpfOneMinusG * yn + lpfG * lpfZ1;
+            lpfZ1.store(lpfOut);
+
+            // --- 3) scatter: write the delay lines
+            for (int i = 0; i < NUM_BRANCHES; i++)
+            {
+                if (!outerAPFBypassed[i])
+                {
+                    if (!innerAPFBypassed[i])
+                        innerAPFDelays[i].writeDelay(innerWn[i]);
+
+                    outerAPFDelays[i].writeDelay(innerYn[i]);
+                }
+                branchDelays[i].writeDelay(lpfOut[i]);
+            }
+
+        }
+
+        lpfZ1.store(lpfState);
+
+        // --- gather outputs: the taps only read the branch delays, so they can wait for the end of the block
+        mixReverbTankOutputsBlock(branchDelays, outputTaps, parameters.density, outL, outR, numSamples);
+    }
+
+private:
+    /** clear the LPF and control rate modulation state of every branch */
+    void clearState()
+    {
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            lfoUpdateCounter[i] = 0;
+            modDelayStarted[i] = false;
+            lpfState[i] = 0.0;
+        }
+    }
+
+    /** render the outer APF LFOs of the branches that use them for the next numSamples samples */
+    void renderModulationBlock(int numSamples)
+    {
+        for (int i = 0; i < NUM_BRANCHES; i++)
+        {
+            lfoBlockIndex[i] = 0;
+            if (!apfParameters[i].enableLFO || outerAPFBypassed[i])
+                continue;
+
+            // --- at control rate, the LFO is only evaluated when the update counter runs out; the first update
+            //     after a reset also needs the value at the start of its interval
+            int lfoInterval = getLFOUpdateInterval(i);
+            int lfoBlockLength = numSamples;
+            if (lfoInterval > 1)
+            {
+                lfoBlockLength = (int)lfoUpdateCounter[i] < numSamples ? 1 + (numSamples - 1 - lfoUpdateCounter[i]) / lfoInterval : 0;
+                if (lfoBlockLength > 0 && !modDelayStarted[i])
+                    lfoBlockLength++;
+            }
+
+            modLFOs[i].renderBlock(lfoBlock[i], lfoBlockLength, generatorOutput::kNormal, lfoInterval);
+        }
+    }
+
+    /** LFO update interval of one branch in samples, at least 1 */
+    inline int getLFOUpdateInterval(int branch)
+    {
+        return apfParameters[branch].lfoUpdateInterval > 1 ? (int)apfParameters[branch].lfoUpdateInterval : 1;
+    }
+
+    /** calculate the modulated delay time of one branch for an LFO output value */
+    inline double calculateModulatedDelay_mSec(int branch, double lfoOutput)
+    {
+        const NestedDelayAPFParameters& apfParams = apfParameters[branch];
+        double maxDelay = apfParams.outerAPFdelayTime_mSec;
+        double minDelay = maxDelay - apfParams.lfoMaxModulation_mSec;
+        minDelay = fmax(0.0, minDelay); // bound minDelay to 0 as minimum
+
+        // --- the four-point and allpass interpolators need at least one sample of delay
+        if (Interpolator<T>::MIN_DELAY_SAMPLES > 0 && apfParams.interpolate)
+            minDelay = fmax(Interpolator<T>::MIN_DELAY_SAMPLES * 1000.0 / sampleRate, minDelay);
+
+        // --- calc max-down modulated value with unipolar converted LFO output
+        //     NOTE: LFO output is scaled by lfoDepth
+        return doUnipolarModulationFromMax(bipolarToUnipolar(apfParams.lfoDepth * lfoOutput),
+            minDelay, maxDelay);
+    }
+
+    /** read the outer APF delay of one branch, modulated by its LFO if enabled; mirrors DelayAPF */
+    inline T readOuterAPFDelay(int branch)
+    {
+        if (!apfParameters[branch].enableLFO)
+            return outerAPFDelays[branch].readDelay();
+
+        int lfoInterval = getLFOUpdateInterval(branch);
+        if (lfoInterval == 1)
+            return outerAPFDelays[branch].readDelayAtTime_mSec(calculateModulatedDelay_mSec(branch, lfoBlock[branch][lfoBlockIndex[branch]++]));
+
+        // --- control rate: ramp from the LFO value at the start of the interval to the one at its end
+        if (lfoUpdateCounter[branch] == 0)
+        {
+            if (!modDelayStarted[branch])
+            {
+                modDelayTarget_mSec[branch] = calculateModulatedDelay_mSec(branch, lfoBlock[branch][lfoBlockIndex[branch]++]);
+                modDelayStarted[branch] = true;
+            }
+
+            modDelay_mSec[branch] = modDelayTarget_mSec[branch];
+            modDelayTarget_mSec[branch] = calculateModulatedDelay_mSec(branch, lfoBlock[branch][lfoBlockIndex[branch]++]);
+            modDelayIncrement_mSec[branch] = (modDelayTarget_mSec[branch] - modDelay_mSec[branch]) / lfoInterval;
+            lfoUpdateCounter[branch] = lfoInterval;
+        }
+
+        lfoUpdateCounter[branch]--;
+        double delay_mSec = modDelay_mSec[branch];
+        modDelay_mSec[branch] += modDelayIncrement_mSec[branch];
+        return outerAPFDelays[branch].readDelayAtTime_mSec(delay_mSec);
+    }
+
+    ReverbTankParameters parameters;						///< object parameters
+    NestedDelayAPFParameters apfParameters[NUM_BRANCHES];	///< nested APF settings for each branch
+
+    // --- delay lines and LFOs (scalar, one per branch)
+    SimpleDelay<T> branchDelays[NUM_BRANCHES];		///< branch delay objects
+    SimpleDelay<T, Interpolator> outerAPFDelays[NUM_BRANCHES];	///< outer APF delays
+    SimpleDelay<T> innerAPFDelays[NUM_BRANCHES];	///< inner (nested) APF delays
+    LFO modLFOs[NUM_BRANCHES];						///< outer APF modulators
+    double lfoBlock[NUM_BRANCHES][LFO_BLOCK_SIZE] = { { 0.0 } };	///< LFO outputs rendered ahead
+    int lfoBlockIndex[NUM_BRANCHES] = { 0 };						///< next sample to use from lfoBlock
+
+    // --- control rate modulation, see DelayAPF
+    unsigned int lfoUpdateCounter[NUM_BRANCHES] = { 0 };		///< samples to go until the next LFO update
+    double modDelay_mSec[NUM_BRANCHES] = { 0.0 };				///< current (interpolated) modulated delay times
+    double modDelayTarget_mSec[NUM_BRANCHES] = { 0.0 };			///< modulated delay times at the end of the current intervals
+    double modDelayIncrement_mSec[NUM_BRANCHES] = { 0.0 };		///< per sample delay time increments
+    bool modDelayStarted[NUM_BRANCHES] = { false };				///< false until the first LFO update after a reset
+    DelayTap<T> outputTaps[NUM_BRANCHES][NUM_TAPS_PER_BRANCH];	///< output tap table, rebuilt when the fixed delays change
+
+    // --- lanes: index = branch
+    T outerAPF_g[NUM_BRANCHES] = { 0.0 };		///< outer APF g coefficients
+    T outerAPF_negG[NUM_BRANCHES] = { 0.0 };	///< outer APF -g coefficients
+    T innerAPF_g[NUM_BRANCHES] = { 0.0 };		///< inner APF g coefficients
+    T innerAPF_negG[NUM_BRANCHES] = { 0.0 };	///< inner APF -g coefficients
+    T lpf_g[NUM_BRANCHES] = { 0.0 };			///< LPF g coefficients
+    T lpf_oneMinusG[NUM_BRANCHES] = { 0.0 };	///< LPF (1 - g) coefficients
+    T lpfState[NUM_BRANCHES] = { 0.0 };			///< LPF state registers (z^-1)
+
+    bool outerAPFBypassed[NUM_BRANCHES] = { false };	///< zero length outer APFs
+    bool innerAPFBypassed[NUM_BRANCHES] = { false };	///< zero length inner APFs
+    bool anyAPFBypassed = false;						///< at least one lane needs the bypass fix-up
+    bool forceParameterUpdate = true;	///< recalculate everything on the next setParameters( )
+    double sampleRate = 0.0;			///< current sample rate
+};
\ No newline at end of file
@@ -33,6 +33,7 @@ struct ReverbTankParameters
 
         lpf_g = params.lpf_g;
         kRT = params.kRT;
+        interpolateModulation = params.interpolateModulation;
 
         lowShelf_fc = params.lowShelf_fc;
         lowShelfBoostCut_dB = params.lowShelfBoostCut_dB;
@@ -54,6 +55,7 @@ struct ReverbTankParameters
     double apfDelayWeight_Pct = 85.0;				///< APF max delay weighying
     double fixeDelayMax_mSec = 81.0;				///< fixed delay max time
     double fixeDelayWeight_Pct = 100.0;				///< fixed delay max weighying
+    bool interpolateModulation = false;				///< interpolate the modulated APF reads (see the tank's Interpolator)
 
     // --- direct control parameters
     double preDelayTime_mSec = 150.0;					///< pre-delay time in mSec
@@ -0,0 +1,200 @@
+// SIMDVector4.h
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Utilities.h"
+
+// --- pick the instruction set; anything else uses the plain C++ fallback (which most compilers
+//     will still auto-vectorize)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define JVERB_SIMD_SSE2 1
+ #include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (defined(__aarch64__) || defined(_M_ARM64))
+ #define JVERB_SIMD_NEON 1
+ #include <arm_neon.h>
+#endif
+
+/**
+\class SIMDVector4
+\ingroup FX-Objects
+\brief
+The SIMDVector4 object holds four lanes of float or double samples and does element-wise math on them
+with SSE2 (x86) or NEON (arm64) instructions; double uses two 2-wide registers.
+
+NOTE: this is NOT an IAudioSignalProcessor; it is the lane type for structure-of-arrays processing,
+e.g. running the four reverb tank branches side by side. Loads and stores are unaligned.
+
+Only the operations the DSP objects need are here; each one rounds exactly like the scalar code
+it replaces (no fused multiply-add), so SIMD and scalar versions of an object agree bit-for-bit.
+*/
+template <typename T>
+struct SIMDVector4
+{
+    SIMDVector4() {}
+    explicit SIMDVector4(T value) { for (int i = 0; i < 4; i++) v[i] = value; }
+
+    /** read four lanes from memory */
+    static SIMDVector4 load(const T* source)
+    {
+        SIMDVector4 result;
+        for (int i = 0; i < 4; i++) result.v[i] = source[i];
+        return result;
+    }
+
+    /** write four lanes to memory */
+    void store(T* destination) const { for (int i = 0; i < 4; i++) destination[i] = v[i]; }
+
+    SIMDVector4 operator+(const SIMDVector4& b) const { SIMDVector4 r; for (int i = 0; i < 4; i++) r.v[i] = v[i] + b.v[i]; return r; }
+    SIMDVector4 operator-(const SIMDVector4& b) const { SIMDVector4 r; for (int i = 0; i < 4; i++) r.v[i] = v[i] - b.v[i]; return r; }
+    SIMDVector4 operator*(const SIMDVector4& b) const { SIMDVector4 r; for (int i = 0; i < 4; i++) r.v[i] = v[i] * b.v[i]; return r; }
+
+    /** absolute value of every lane */
+    SIMDVector4 abs() const { SIMDVector4 r; for (int i = 0; i < 4; i++) r.v[i] = std::abs(v[i]); return r; }
+
+    /** checkFloatUnderflow( ) on every lane */
+    SIMDVector4 flushUnderflow() const
+    {
+        SIMDVector4 r = *this;
+        for (int i = 0; i < 4; i++) checkFloatUnderflow(r.v[i]);
+        return r;
+    }
+
+    /** { first, second, lane 0, lane 1 }: lanes 0 and 1 move up to 2 and 3 and a new pair comes in below */
+    SIMDVector4 pushPair(T first, T second) const { SIMDVector4 r; r.v[0] = first; r.v[1] = second; r.v[2] = v[0]; r.v[3] = v[1]; return r; }
+
+    /** read one lane */
+    template <int lane> T getLane() const { return v[lane]; }
+
+    T v[4];
+};
+
+#if JVERB_SIMD_SSE2
+/** SSE2 float lanes */
+template <>
+struct SIMDVector4<float>
+{
+    SIMDVector4() {}
+    explicit SIMDVector4(float value) : v(_mm_set1_ps(value)) {}
+    explicit SIMDVector4(__m128 _v) : v(_v) {}
+
+    static SIMDVector4 load(const float* source) { return SIMDVector4(_mm_loadu_ps(source)); }
+    void store(float* destination) const { _mm_storeu_ps(destination, v); }
+
+    SIMDVector4 operator+(const SIMDVector4& b) const { return SIMDVector4(_mm_add_ps(v, b.v)); }
+    SIMDVector4 operator-(const SIMDVector4& b) const { return SIMDVector4(_mm_sub_ps(v, b.v)); }
+    SIMDVector4 operator*(const SIMDVector4& b) const { return SIMDVector4(_mm_mul_ps(v, b.v)); }
+    SIMDVector4 abs() const { return SIMDVector4(_mm_andnot_ps(_mm_set1_ps(-0.0f), v)); }
+
+    /** zero any lane with 0 < |x| < FLT_MIN */
+    SIMDVector4 flushUnderflow() const
+    {
+        __m128 magnitude = _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+        __m128 tiny = _mm_cmplt_ps(magnitude, _mm_set1_ps((float)kSmallestPositiveFloatValue));
+        return SIMDVector4(_mm_andnot_ps(tiny, v));
+    }
+
+    SIMDVector4 pushPair(float first, float second) const { return SIMDVector4(_mm_movelh_ps(_mm_unpacklo_ps(_mm_set_ss(first), _mm_set_ss(second)), v)); }
+    template <int lane> float getLane() const { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(lane, lane, lane, lane))); }
+
+    __m128 v;
+};
+
+/** SSE2 double lanes: two registers of two */
+template <>
+struct SIMDVector4<double>
+{
+    SIMDVector4() {}
+    explicit SIMDVector4(double value) : lo(_mm_set1_pd(value)), hi(_mm_set1_pd(value)) {}
+    SIMDVector4(__m128d _lo, __m128d _hi) : lo(_lo), hi(_hi) {}
+
+    static SIMDVector4 load(const double* source) { return SIMDVector4(_mm_loadu_pd(source), _mm_loadu_pd(source + 2)); }
+    void store(double* destination) const { _mm_storeu_pd(destination, lo); _mm_storeu_pd(destination + 2, hi); }
+
+    SIMDVector4 operator+(const SIMDVector4& b) const { return SIMDVector4(_mm_add_pd(lo, b.lo), _mm_add_pd(hi, b.hi)); }
+    SIMDVector4 operator-(const SIMDVector4& b) const { return SIMDVector4(_mm_sub_pd(lo, b.lo), _mm_sub_pd(hi, b.hi)); }
+    SIMDVector4 operator*(const SIMDVector4& b) const { return SIMDVector4(_mm_mul_pd(lo, b.lo), _mm_mul_pd(hi, b.hi)); }
+    SIMDVector4 abs() const { __m128d sign = _mm_set1_pd(-0.0); return SIMDVector4(_mm_andnot_pd(sign, lo), _mm_andnot_pd(sign, hi)); }
+
+    /** zero any lane with 0 < |x| < FLT_MIN (the same float threshold the scalar check uses) */
+    SIMDVector4 flushUnderflow() const
+    {
+        __m128d sign = _mm_set1_pd(-0.0);
+        __m128d threshold = _mm_set1_pd(kSmallestPositiveFloatValue);
+        __m128d tinyLo = _mm_cmplt_pd(_mm_andnot_pd(sign, lo), threshold);
+        __m128d tinyHi = _mm_cmplt_pd(_mm_andnot_pd(sign, hi), threshold);
+        return SIMDVector4(_mm_andnot_pd(tinyLo, lo), _mm_andnot_pd(tinyHi, hi));
+    }
+
+    SIMDVector4 pushPair(double first, double second) const { return SIMDVector4(_mm_set_pd(second, first), lo); }
+
+    template <int lane> double getLane() const
+    {
+        __m128d half = lane < 2 ? lo : hi;
+        return _mm_cvtsd_f64((lane & 1) ? _mm_unpackhi_pd(half, half) : half);
+    }
+
+    __m128d lo, hi;
+};
+#elif JVERB_SIMD_NEON
+/** NEON float lanes */
+template <>
+struct SIMDVector4<float>
+{
+    SIMDVector4() {}
+    explicit SIMDVector4(float value) : v(vdupq_n_f32(value)) {}
+    explicit SIMDVector4(float32x4_t _v) : v(_v) {}
+
+    static SIMDVector4 load(const float* source) { return SIMDVector4(vld1q_f32(source)); }
+    void store(float* destination) const { vst1q_f32(destination, v); }
+
+    SIMDVector4 operator+(const SIMDVector4& b) const { return SIMDVector4(vaddq_f32(v, b.v)); }
+    SIMDVector4 operator-(const SIMDVector4& b) const { return SIMDVector4(vsubq_f32(v, b.v)); }
+    SIMDVector4 operator*(const SIMDVector4& b) const { return SIMDVector4(vmulq_f32(v, b.v)); }
+    SIMDVector4 abs() const { return SIMDVector4(vabsq_f32(v)); }
+
+    /** zero any lane with 0 < |x| < FLT_MIN */
+    SIMDVector4 flushUnderflow() const
+    {
+        uint32x4_t tiny = vcltq_f32(vabsq_f32(v), vdupq_n_f32((float)kSmallestPositiveFloatValue));
+        return SIMDVector4(vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(v), tiny)));
+    }
+
+    SIMDVector4 pushPair(float first, float second) const { return SIMDVector4(vcombine_f32(vset_lane_f32(second, vdup_n_f32(first), 1), vget_low_f32(v))); }
+    template <int lane> float getLane() const { return vgetq_lane_f32(v, lane); }
+
+    float32x4_t v;
+};
+
+/** NEON double lanes: two registers of two */
+template <>
+struct SIMDVector4<double>
+{
+    SIMDVector4() {}
+    explicit SIMDVector4(double value) : lo(vdupq_n_f64(value)), hi(vdupq_n_f64(value)) {}
+    SIMDVector4(float64x2_t _lo, float64x2_t _hi) : lo(_lo), hi(_hi) {}
+
+    static SIMDVector4 load(const double* source) { return SIMDVector4(vld1q_f64(source), vld1q_f64(source + 2)); }
+    void store(double* destination) const { vst1q_f64(destination, lo); vst1q_f64(destination + 2, hi); }
+
+    SIMDVector4 operator+(const SIMDVector4& b) const { return SIMDVector4(vaddq_f64(lo, b.lo), vaddq_f64(hi, b.hi)); }
+    SIMDVector4 operator-(const SIMDVector4& b) const { return SIMDVector4(vsubq_f64(lo, b.lo), vsubq_f64(hi, b.hi)); }
+    SIMDVector4 operator*(const SIMDVector4& b) const { return SIMDVector4(vmulq_f64(lo, b.lo), vmulq_f64(hi, b.hi)); }
+    SIMDVector4 abs() const { return SIMDVector4(vabsq_f64(lo), vabsq_f64(hi)); }
+
+    /** zero any lane with 0 < |x| < FLT_MIN (the same float threshold the scalar check uses) */
+    SIMDVector4 flushUnderflow() const
+    {
+        float64x2_t threshold = vdupq_n_f64(kSmallestPositiveFloatValue);
+        uint64x2_t tinyLo = vcltq_f64(vabsq_f64(lo), threshold);
+        uint64x2_t tinyHi = vcltq_f64(vabsq_f64(hi), threshold);
+        return SIMDVector4(vreinterpretq_f64_u64(vbicq_u64(vreinterpretq_u64_f64(lo), tinyLo)),
+                           vreinterpretq_f64_u64(vbicq_u64(vreinterpretq_u64_f64(hi), tinyHi)));
+    }
+
+    SIMDVector4 pushPair(double first, double second) const { return SIMDVector4(vsetq_lane_f64(second, vdupq_n_f64(first), 1), lo); }
+    template <int lane> double getLane() const { return vgetq_lane_f64(lane < 2 ? lo : hi, lane & 1); }
+
+    float64x2_t lo, hi;
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,136 @@
+// ShelvingCoefficientRamp.h
+
+#pragma once
+
+#include <cstring>
+#include "Utilities.h"
+
+/**
+\class ShelvingCoefficientRamp
+\ingroup FX-Objects
+\brief
+The ShelvingCoefficientRamp object holds the coefficients of a low and a high shelf and moves them linearly,
+one sample at a time, from the ones running to the latest designs. It is the coefficient ramp shared by
+TwoBandShelvingFilter and StereoShelvingFilter; the owner designs the shelves and puts getCoefficients( )
+on its biquads whenever they change.
+
+NOTE: this is NOT an IAudioSignalProcessor; it processes no audio.
+
+Control I/F:
+- setTargets( ) at control rate, then start( ) at the top of the next block.
+- advance( ) once per sample while isRamping( ).
+*/
+class ShelvingCoefficientRamp
+{
+public:
+    enum { LOW_SHELF, HIGH_SHELF, NUM_STAGES };
+
+    ShelvingCoefficientRamp() {}		/* C-TOR */
+    ~ShelvingCoefficientRamp() {}		/* D-TOR */
+
+    /** take designed coefficients as both the running and the target ones (no ramp); after a reset( ) of the
+        owner these are the designs of its current parameters, so the next change still ramps from them */
+    /**
+    \param lowShelfCoeffs numCoeffs coefficients of the low shelf
+    \param highShelfCoeffs numCoeffs coefficients of the high shelf
+    */
+    void capture(const double* lowShelfCoeffs, const double* highShelfCoeffs)
+    {
+        memcpy(&currentCoeffs[LOW_SHELF][0], lowShelfCoeffs, sizeof(double) * numCoeffs);
+        memcpy(&currentCoeffs[HIGH_SHELF][0], highShelfCoeffs, sizeof(double) * numCoeffs);
+        memcpy(&targetCoeffs[0][0], &currentCoeffs[0][0], sizeof(targetCoeffs));
+
+        rampSamplesRemaining = 0;
+        newTargetPending = false;
+    }
+
+    /** store new target coefficients; the ramp to them starts at the next start( ) */
+    /**
+    \param lowShelfCoeffs numCoeffs coefficients of the low shelf
+    \param highShelfCoeffs numCoeffs coefficients of the high shelf
+    */
+    void setTargets(const double* lowShelfCoeffs, const double* highShelfCoeffs)
+    {
+        memcpy(&targetCoeffs[LOW_SHELF][0], lowShelfCoeffs, sizeof(double) * numCoeffs);
+        memcpy(&targetCoeffs[HIGH_SHELF][0], highShelfCoeffs, sizeof(double) * numCoeffs);
+
+        // --- before the first design there is nothing to ramp from
+        if (jumpToNextTarget)
+        {
+            jumpToNextTarget = false;
+            snapToTargets();
+        }
+        else
+            newTargetPending = true;
+    }
+
+    /** ramp from the running coefficients to the pending targets over numSamples */
+    /**
+    \param numSamples length of the ramp in samples
+    */
+    void start(int numSamples)
+    {
+        if (!newTargetPending)
+            return;
+
+        newTargetPending = false;
+        if (numSamples < 1)
+            numSamples = 1;
+
+        for (int stage = 0; stage < NUM_STAGES; stage++)
+        {
+            for (int i = 0; i < numCoeffs; i++)
+                rampIncrement[stage][i] = (targetCoeffs[stage][i] - currentCoeffs[stage][i]) / numSamples;
+        }
+        rampSamplesRemaining = numSamples;
+    }
+
+    /** move the coefficients one sample along the ramp; lands exactly on the targets */
+    inline void advance()
+    {
+        if (--rampSamplesRemaining == 0)
+            memcpy(&currentCoeffs[0][0], &targetCoeffs[0][0], sizeof(targetCoeffs));
+        else
+        {
+            for (int stage = 0; stage < NUM_STAGES; stage++)
+            {
+                for (int i = 0; i < numCoeffs; i++)
+                    currentCoeffs[stage][i] += rampIncrement[stage][i];
+            }
+        }
+    }
+
+    /** end any ramp on the targets, pending or not */
+    void snapToTargets()
+    {
+        memcpy(&currentCoeffs[0][0], &targetCoeffs[0][0], sizeof(targetCoeffs));
+        rampSamplesRemaining = 0;
+        newTargetPending = false;
+    }
+
+    /** true if setTargets( ) was called and the ramp to them has not started */
+    bool isTargetPending() const { return newTargetPending; }
+
+    /** true while advance( ) moves the coefficients */
+    bool isRamping() const { return rampSamplesRemaining > 0; }
+
+    /** the coefficients to run now */
+    /**
+    \param stage LOW_SHELF or HIGH_SHELF
+    */
+    const double* getCoefficients(int stage) const { return currentCoeffs[stage]; }
+
+    /** the latest designed coefficients */
+    /**
+    \param stage LOW_SHELF or HIGH_SHELF
+    */
+    const double* getTargetCoefficients(int stage) const { return targetCoeffs[stage]; }
+
+private:
+    double currentCoeffs[NUM_STAGES][numCoeffs] = { { 0.0 } };	///< coefficients to run now
+    double targetCoeffs[NUM_STAGES][numCoeffs] = { { 0.0 } };	///< latest designed coefficients
+    double rampIncrement[NUM_STAGES][numCoeffs] = { { 0.0 } };	///< per-sample coefficient increments
+    int rampSamplesRemaining = 0;		///< samples left in the current ramp
+    bool newTargetPending = false;		///< targets changed, ramp not started yet
+    bool jumpToNextTarget = true;		///< no valid coefficients to ramp from (not designed yet)
+};
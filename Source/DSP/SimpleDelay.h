@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CircularBuffer.h"
+#include "MirroredCircularBuffer.h"
+#include "DelayArena.h"
 
 /**
 \class SimpleDelay
@@ -15,13 +17,20 @@ Audio I/O:
 
 Control I/F:
 - Use SimpleDelayParameters structure to get/set object params.
+- Template parameter T is the sample type (float or double) of the delay buffer and audio I/O.
+- Template parameter Interpolator is the fractional delay interpolator policy (see DelayInterpolators.h);
+  it is used when SimpleDelayParameters::interpolate is set.
+- Template parameter Storage is the delay line storage: CircularBuffer (default) or MirroredCircularBuffer,
+  whose reads are contiguous with no wrap logic.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class SimpleDelay : public IAudioSignalProcessor
+template <typename T, template <typename> class Interpolator = LinearInterpolator,
+          template <typename, template <typename> class> class Storage = CircularBuffer>
+class SimpleDelay : public IAudioSignalProcessor<T>
 {
 public:
     SimpleDelay(void) {}	/* C-TOR */
@@ -29,22 +38,35 @@ public:
 
 public:
     /** reset members to initialized state */
+    /**
+    A new sample rate re-slices the buffer in its current memory (owned or attached); that only allocates
+    if the memory is too small for the new rate.
+    */
     virtual bool reset(double _sampleRate)
     {
         // --- if sample rate did not change
         if (sampleRate == _sampleRate)
         {
             // --- just flush buffer and return
-            delayBuffer.flushBuffer();
+            flush();
             return true;
         }
 
-        // --- create new buffer, will store sample rate and length(mSec)
-        createDelayBuffer(_sampleRate, bufferLength_mSec);
+        // --- create new buffer, will store sample rate, max delay and headroom (mSec)
+        createDelayBuffer(_sampleRate, maxDelay_mSec, headroom_mSec);
+
+        // --- the delay in samples changed with the sample rate
+        setParameters(simpleDelayParameters);
 
         return true;
     }
 
+    /** flush the delay line; the sample rate and buffer are unchanged and nothing is allocated */
+    void flush()
+    {
+        delayBuffer.flushBuffer();
+    }
+
     /** get parameters: note use of custom structure for passing param data */
     /**
     \return SimpleDelayParameters custom data structure
@@ -61,7 +83,21 @@ public:
     void setParameters(const SimpleDelayParameters& params)
     {
         simpleDelayParameters = params;
+
+        // --- the longest delay createDelayBuffer( ) asked for; the headroom is not for longer delays
+        if (maxDelay_mSec > 0.0)
+            boundValue(simpleDelayParameters.delayTime_mSec, 0.0, maxDelay_mSec);
+
         simpleDelayParameters.delay_Samples = simpleDelayParameters.delayTime_mSec * (samplesPerMSec);
+
+        // --- the four-point and allpass interpolators need at least one sample of delay (0 is a bypass)
+        const double minDelay_Samples = Interpolator<T>::MIN_DELAY_SAMPLES;
+        if (simpleDelayParameters.interpolate && simpleDelayParameters.delay_Samples > 0.0 &&
+            simpleDelayParameters.delay_Samples < minDelay_Samples)
+        {
+            simpleDelayParameters.delay_Samples = minDelay_Samples;
+            simpleDelayParameters.delayTime_mSec = minDelay_Samples / samplesPerMSec;
+        }
         delayBuffer.setInterpolate(simpleDelayParameters.interpolate);
     }
 
@@ -70,13 +106,13 @@ public:
     \param xn input
     \return the processed sample
     */
-    virtual double processAudioSample(double xn)
+    virtual T processAudioSample(T xn)
     {
         // --- read delay
         if (simpleDelayParameters.delay_Samples == 0)
             return xn;
 
-        double yn = delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
+        T yn = delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
 
         // --- write to delay buffer
         delayBuffer.writeBuffer(xn);
@@ -85,33 +121,66 @@ public:
         return yn;
     }
 
+    /** process a block of MONO audio through the delay */
+    /**
+    \param input input samples
+    \param output output samples (may be the same buffer as input)
+    \param numSamples number of samples to process
+    */
+    virtual void processBlock(const T* input, T* output, int numSamples)
+    {
+        // --- sample by sample for a zero delay or if the block would overwrite samples it still has
+        //     to read (see readBlock( ))
+        double delay_Samples = simpleDelayParameters.delay_Samples;
+        if (delay_Samples == 0 || (unsigned int)delay_Samples + numSamples + 3 > delayBuffer.getBufferLength())
+        {
+            for (int i = 0; i < numSamples; i++)
+                output[i] = SimpleDelay::processAudioSample(input[i]);
+            return;
+        }
+
+        // --- else write the block, then read it back; input is used up before output is written
+        delayBuffer.writeBlock(input, numSamples);
+        delayBuffer.readBlock(delay_Samples, output, numSamples);
+    }
+
     /** reset members to initialized state */
     virtual bool canProcessAudioFrame() { return false; }
 
-    /** create a new delay buffer */
-    void createDelayBuffer(double _sampleRate, double _bufferLength_mSec)
+    /** create a new delay buffer for delays up to _maxDelay_mSec, the longest delay setParameters( ) will accept */
+    /**
+    \param _headroom_mSec extra length for reads that lag the writes, e.g. a block read after the block is written
+    */
+    void createDelayBuffer(double _sampleRate, double _maxDelay_mSec, double _headroom_mSec = 0.0)
     {
-        // --- store for math
-        bufferLength_mSec = _bufferLength_mSec;
-        sampleRate = _sampleRate;
-        samplesPerMSec = sampleRate / 1000.0;
-
-        // --- total buffer length including fractional part
-        bufferLength = (unsigned int)(bufferLength_mSec * (samplesPerMSec)) + 1; // +1 for fractional part
+        setBufferLength(_sampleRate, _maxDelay_mSec, _headroom_mSec);
 
         // --- create new buffer
         delayBuffer.createCircularBuffer(bufferLength);
     }
 
+    /** create a new delay buffer in memory carved from a DelayArena; does nothing but count the memory
+        during the arena's layout pass */
+    void createDelayBuffer(double _sampleRate, double _maxDelay_mSec, DelayArena<T>& arena, double _headroom_mSec = 0.0)
+    {
+        setBufferLength(_sampleRate, _maxDelay_mSec, _headroom_mSec);
+
+        unsigned int bufferLengthPowerOfTwo = Storage<T, Interpolator>::getPowerOfTwoLength(bufferLength);
+        T* memory = arena.carve(Storage<T, Interpolator>::getStorageLength(bufferLengthPowerOfTwo));
+
+        if (memory)
+            delayBuffer.attachBuffer(memory, bufferLengthPowerOfTwo);
+    }
+
     /** read delay at current location */
-    double readDelay()
+    T readDelay()
     {
         // --- simple read
         return delayBuffer.readBuffer(simpleDelayParameters.delay_Samples);
     }
 
     /** read delay at current location */
-    double readDelayAtTime_mSec(double _delay_mSec)
+    T readDelayAtTime_mSec(double _delay_mSec)
     {
         // --- calculate total delay time in samples + fraction
         double _delay_Samples = _delay_mSec * (samplesPerMSec);
@@ -121,27 +190,59 @@ public:
     }
 
     /** read delay at a percentage of total length */
-    double readDelayAtPercentage(double delayPercent)
+    T readDelayAtPercentage(double delayPercent)
     {
         // --- simple read
         return delayBuffer.readBuffer((delayPercent / 100.0) * simpleDelayParameters.delay_Samples);
     }
 
+    /** make a tap table entry for a read at a percentage of the delay time; see DelayTap */
+    DelayTap<T> getTapAtPercentage(double delayPercent, T gain = 1.0)
+    {
+        return delayBuffer.makeTap((delayPercent / 100.0) * simpleDelayParameters.delay_Samples, gain);
+    }
+
+    /** read several taps at the current location in one pass: outputs[k] = gain * value of taps[k] */
+    void readTaps(const DelayTap<T>* taps, int numTaps, T* outputs)
+    {
+        delayBuffer.readTaps(taps, numTaps, outputs);
+    }
+
+    /** mix several taps into output over the block of numSamples that was just written */
+    void mixTapsBlock(const DelayTap<T>* taps, int numTaps, T* output, int numSamples)
+    {
+        delayBuffer.mixTapsBlock(taps, numTaps, output, numSamples);
+    }
+
     /** write a new value into the delay */
-    void writeDelay(double xn)
+    void writeDelay(T xn)
     {
         // --- simple write
         delayBuffer.writeBuffer(xn);
     }
 
 private:
+    /** store the sample rate, max delay and buffer length for a new delay buffer */
+    void setBufferLength(double _sampleRate, double _maxDelay_mSec, double _headroom_mSec)
+    {
+        // --- store for math
+        maxDelay_mSec = _maxDelay_mSec;
+        headroom_mSec = _headroom_mSec;
+        sampleRate = _sampleRate;
+        samplesPerMSec = sampleRate / 1000.0;
+
+        // --- total buffer length including headroom and fractional part
+        bufferLength = (unsigned int)((maxDelay_mSec + headroom_mSec) * (samplesPerMSec)) + 3; // +3 for fractional part (four-point interpolators read 2 past the delay)
+    }
+
     SimpleDelayParameters simpleDelayParameters; ///< object parameters
 
     double sampleRate = 0.0;		///< sample rate
     double samplesPerMSec = 0.0;	///< samples per millisecond (for arbitrary access)
-    double bufferLength_mSec = 0.0; ///< total buffer lenth in mSec
+    double maxDelay_mSec = 0.0;		///< longest delay time in mSec
+    double headroom_mSec = 0.0;		///< buffer length beyond the longest delay in mSec
     unsigned int bufferLength = 0;	///< buffer length in samples
 
-    // --- delay buffer of doubles
-    CircularBuffer<double> delayBuffer; ///< circular buffer for delay
+    // --- delay buffer of samples
+    Storage<T, Interpolator> delayBuffer; ///< circular buffer for delay
 };
\ No newline at end of file
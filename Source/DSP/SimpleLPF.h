@@ -13,13 +13,15 @@ Audio I/O:
 
 Control I/F:
 - Use SimpleLPFParameters structure to get/set object params.
+- Template parameter T is the sample type (float or double).
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class SimpleLPF : public IAudioSignalProcessor
+template <typename T>
+class SimpleLPF : public IAudioSignalProcessor<T>
 {
 public:
     SimpleLPF(void) {}	/* C-TOR */
@@ -56,18 +58,37 @@ public:
     \param xn input
     \return the processed sample
     */
-    virtual double processAudioSample(double xn)
+    virtual T processAudioSample(T xn)
     {
-        double g = simpleLPFParameters.g;
-        double yn = (1.0 - g) * xn + g * state;
+        T g = (T)simpleLPFParameters.g;
+        T yn = ((T)1.0 - g) * xn + g * state;
         state = yn;
         return yn;
     }
 
+    /** process a block through the simple one pole FB back filter */
+    /**
+    \param input input samples
+    \param output output samples (may be the same buffer as input)
+    \param numSamples number of samples to process
+    */
+    virtual void processBlock(const T* input, T* output, int numSamples)
+    {
+        T g = (T)simpleLPFParameters.g;
+        T z1 = state;
+        for (int i = 0; i < numSamples; i++)
+        {
+            T yn = ((T)1.0 - g) * input[i] + g * z1;
+            z1 = yn;
+            output[i] = yn;
+        }
+        state = z1;
+    }
+
     /** return false: this object only processes samples */
     virtual bool canProcessAudioFrame() { return false; }
 
 private:
     SimpleLPFParameters simpleLPFParameters;	///< object parameters
-    double state = 0.0;							///< single state (z^-1) register
+    T state = 0.0;								///< single state (z^-1) register
 };
\ No newline at end of file
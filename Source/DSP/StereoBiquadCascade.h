@@ -0,0 +1,141 @@
+// StereoBiquadCascade.h
+
+#pragma once
+
+#include "SIMDVector4.h"
+#include "Utilities.h"
+
+/**
+\class StereoBiquadCascade
+\ingroup FX-Objects
+\brief
+The StereoBiquadCascade object runs two filter stages in series on a left and a right channel, all four
+biquads in the lanes of one SIMDVector4. The channels share each stage's coefficients and keep their own states.
+
+Audio I/O:
+- Processes stereo input to stereo output, in place.
+
+Control I/F:
+- setStageCoefficients( ) takes an AudioFilter coefficient array (a0 to b2 plus the c0 and d0 wet/dry mix) per stage.
+- Template parameter T is the sample type (float or double) of the audio, coefficients and states.
+
+The second stage needs the first stage's output of the same sample, so the lanes are skewed by one sample:
+lanes 0 and 1 run stage 0 on sample n while lanes 2 and 3 run stage 1 on sample n - 1. processBlock( ) runs
+stage 0 alone on the first sample and stage 1 alone on the last, so the skew adds no latency. Every lane does
+the transposed canonical biquad of Biquad and the wet/dry mix of AudioFilter in the same order, so the output
+is bit-identical to two AudioFilters in series on each channel.
+
+NOTE: this is NOT an IAudioSignalProcessor (it is stereo only).
+*/
+template <typename T>
+class StereoBiquadCascade
+{
+public:
+    StereoBiquadCascade() {}		/* C-TOR */
+    ~StereoBiquadCascade() {}		/* D-TOR */
+
+    enum { NUM_STAGES = 2 };
+
+    /** clear the states of all four biquads */
+    void reset()
+    {
+        memset(&stateLanes[0][0], 0, sizeof(stateLanes));
+    }
+
+    /** set the coefficients of one stage, for both channels */
+    /**
+    \param stage 0 (first) or 1 (second)
+    \param coeffs numCoeffs coefficients, as AudioFilter::getCoefficients( )
+    */
+    void setStageCoefficients(int stage, const double* coeffs)
+    {
+        for (int i = 0; i < numCoeffs; i++)
+        {
+            coeffLanes[i][2 * stage] = (T)coeffs[i];
+            coeffLanes[i][2 * stage + 1] = (T)coeffs[i];
+        }
+    }
+
+    /** process one stereo sample through both stages, without the lanes; for sample-by-sample use */
+    /**
+    \param left left sample, replaced by the output
+    \param right right sample, replaced by the output
+    */
+    inline void processSample(T& left, T& right)
+    {
+        left = processLane(2, processLane(0, left));
+        right = processLane(3, processLane(1, right));
+    }
+
+    /** process a block of stereo samples through both stages, in place */
+    /**
+    \param left left samples
+    \param right right samples
+    \param numSamples number of samples to process
+    */
+    void processBlock(T* left, T* right, int numSamples)
+    {
+        typedef SIMDVector4<T> Lanes;
+
+        if (numSamples <= 0)
+            return;
+
+        // --- the first sample only goes through stage 0
+        T firstStage[4] = { processLane(0, left[0]), processLane(1, right[0]), 0.0, 0.0 };
+        Lanes output = Lanes::load(firstStage);
+
+        const Lanes A0 = Lanes::load(coeffLanes[a0]);
+        const Lanes A1 = Lanes::load(coeffLanes[a1]);
+        const Lanes A2 = Lanes::load(coeffLanes[a2]);
+        const Lanes B1 = Lanes::load(coeffLanes[b1]);
+        const Lanes B2 = Lanes::load(coeffLanes[b2]);
+        const Lanes C0 = Lanes::load(coeffLanes[c0]);
+        const Lanes D0 = Lanes::load(coeffLanes[d0]);
+
+        Lanes z1 = Lanes::load(stateLanes[Z1]);
+        Lanes z2 = Lanes::load(stateLanes[Z2]);
+
+        for (int n = 1; n < numSamples; n++)
+        {
+            // --- stage 0 takes sample n, stage 1 takes stage 0's output of sample n - 1
+            Lanes xn = output.pushPair(left[n], right[n]);
+
+            // --- transposed canonical, as Biquad
+            Lanes yn = (A0 * xn + z1).flushUnderflow();
+            z1 = A1 * xn - B1 * yn + z2;
+            z2 = A2 * xn - B2 * yn;
+
+            // --- dry + wet, as AudioFilter
+            output = D0 * xn + C0 * yn;
+
+            left[n - 1] = output.template getLane<2>();
+            right[n - 1] = output.template getLane<3>();
+        }
+
+        z1.store(stateLanes[Z1]);
+        z2.store(stateLanes[Z2]);
+
+        // --- and the last sample only goes through stage 1
+        left[numSamples - 1] = processLane(2, output.template getLane<0>());
+        right[numSamples - 1] = processLane(3, output.template getLane<1>());
+    }
+
+private:
+    enum { Z1, Z2, NUM_STATE_LANES };
+
+    /** one biquad (lane) on one sample, the arithmetic of the lanes in scalar form */
+    inline T processLane(int lane, T xn)
+    {
+        T yn = coeffLanes[a0][lane] * xn + stateLanes[Z1][lane];
+        checkFloatUnderflow(yn);
+
+        stateLanes[Z1][lane] = coeffLanes[a1][lane] * xn - coeffLanes[b1][lane] * yn + stateLanes[Z2][lane];
+        stateLanes[Z2][lane] = coeffLanes[a2][lane] * xn - coeffLanes[b2][lane] * yn;
+
+        return coeffLanes[d0][lane] * xn + coeffLanes[c0][lane] * yn;
+    }
+
+    // --- lanes: 0 = left stage 0, 1 = right stage 0, 2 = left stage 1, 3 = right stage 1
+    T coeffLanes[numCoeffs][4] = { { 0.0 } };			///< each coefficient across the lanes
+    T stateLanes[NUM_STATE_LANES][4] = { { 0.0 } };		///< z^-1 registers across the lanes
+};
\ No newline at end of file
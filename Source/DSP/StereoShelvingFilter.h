@@ -0,0 +1,203 @@
+// StereoShelvingFilter.h
+
+#pragma once
+
+#include "AudioFilter.h"
+#include "TwoBandShelvingFilterParameters.h"
+#include "StereoBiquadCascade.h"
+#include "ShelvingCoefficientRamp.h"
+
+/**
+\class StereoShelvingFilter
+\ingroup FX-Objects
+\brief
+The StereoShelvingFilter object is the TwoBandShelvingFilter for a stereo pair with one set of parameters: the low
+and high shelves of both channels run together in the lanes of a StereoBiquadCascade instead of as four scalar biquads.
+
+Audio I/O:
+- Processes stereo input to stereo output, in place.
+
+Control I/F:
+- Use TwoBandShelvingFilterParameters structure to get/set object params.
+- Template parameter T is the sample type (float or double); coefficients are designed and ramped in double,
+  by the same ShelvingCoefficientRamp as TwoBandShelvingFilter.
+
+The two AudioFilters only design the shelves; the cascade does the processing. Coefficient ramps move every sample,
+so the ramping section of a block runs sample by sample and only the steady section runs in the lanes.
+
+NOTE: this is NOT an IAudioSignalProcessor (it is stereo only).
+*/
+template <typename T>
+class StereoShelvingFilter
+{
+public:
+    StereoShelvingFilter()
+    {
+        AudioFilterParameters params = lowShelfFilter.getParameters();
+        params.algorithm = filterAlgorithm::kLowShelf;
+        lowShelfFilter.setParameters(params);
+
+        params = highShelfFilter.getParameters();
+        params.algorithm = filterAlgorithm::kHiShelf;
+        highShelfFilter.setParameters(params);
+
+        captureDesignedCoefficients();
+    }		/* C-TOR */
+
+    ~StereoShelvingFilter() {}		/* D-TOR */
+
+    /** reset members to initialized state */
+    bool reset(double _sampleRate)
+    {
+        // --- the designs depend on the sample rate
+        lowShelfFilter.reset(_sampleRate);
+        highShelfFilter.reset(_sampleRate);
+        lowShelfFilter.setSampleRate(_sampleRate);
+        highShelfFilter.setSampleRate(_sampleRate);
+
+        cascade.reset();
+        captureDesignedCoefficients();
+        return true;
+    }
+
+    /** flush the filter states and finish any coefficient ramp; nothing is designed or allocated, so this is
+        safe to call from the audio thread (the sample rate and coefficient tables only change in reset( )) */
+    void flush()
+    {
+        cascade.reset();
+
+        coefficientRamp.snapToTargets();
+        updateCascade();
+    }
+
+    /** process one stereo sample through the two filters in series */
+    /**
+    \param left left sample, replaced by the output
+    \param right right sample, replaced by the output
+    */
+    void processAudioFrame(T& left, T& right)
+    {
+        // --- no block to ramp across: jump to any new coefficients
+        if (coefficientRamp.isTargetPending())
+            startCoefficientRamp(1);
+
+        if (coefficientRamp.isRamping())
+            advanceCoefficientRamp();
+
+        cascade.processSample(left, right);
+    }
+
+    /** process a block of stereo samples through the two filters in series, in place */
+    /**
+    \param left left samples
+    \param right right samples
+    \param numSamples number of samples to process
+    */
+    void processBlock(T* left, T* right, int numSamples)
+    {
+        // --- ramp across this block unless the owner already started a (longer) ramp
+        if (coefficientRamp.isTargetPending())
+            startCoefficientRamp(numSamples);
+
+        // --- ramping section: coefficients move every sample
+        int i = 0;
+        for (; i < numSamples && coefficientRamp.isRamping(); i++)
+        {
+            advanceCoefficientRamp();
+            cascade.processSample(left[i], right[i]);
+        }
+
+        // --- steady section: coefficients are fixed
+        if (i < numSamples)
+            cascade.processBlock(left + i, right + i, numSamples - i);
+    }
+
+    /** get parameters: note use of custom structure for passing param data */
+    /**
+    \return TwoBandShelvingFilterParameters custom data structure
+    */
+    TwoBandShelvingFilterParameters getParameters()
+    {
+        return parameters;
+    }
+
+    /** set parameters: note use of custom structure for passing param data */
+    /**
+    NOTE: as TwoBandShelvingFilter, the new coefficients are designed here (call this at control rate) and
+          the filters ramp to them over the next processed block, or the length given to startCoefficientRamp( )
+    \param TwoBandShelvingFilterParameters custom data structure
+    */
+    void setParameters(const TwoBandShelvingFilterParameters& params)
+    {
+        if (params.lowShelf_fc == parameters.lowShelf_fc &&
+            params.lowShelfBoostCut_dB == parameters.lowShelfBoostCut_dB &&
+            params.highShelf_fc == parameters.highShelf_fc &&
+            params.highShelfBoostCut_dB == parameters.highShelfBoostCut_dB)
+            return;
+
+        parameters = params;
+        AudioFilterParameters filterParams = lowShelfFilter.getParameters();
+        filterParams.fc = parameters.lowShelf_fc;
+        filterParams.boostCut_dB = parameters.lowShelfBoostCut_dB;
+        lowShelfFilter.setParameters(filterParams);
+
+        filterParams = highShelfFilter.getParameters();
+        filterParams.fc = parameters.highShelf_fc;
+        filterParams.boostCut_dB = parameters.highShelfBoostCut_dB;
+        highShelfFilter.setParameters(filterParams);
+
+        coefficientRamp.setTargets(lowShelfFilter.getCoefficients(), highShelfFilter.getCoefficients());
+        updateCascade();
+    }
+
+    /** look the shelf designs up in the shared coefficient tables instead of calculating them; takes effect at
+        the next reset( ), see AudioFilter::setUseCoefficientTable( ) */
+    /**
+    \param use true to use the tables
+    */
+    void setUseCoefficientTables(bool use)
+    {
+        lowShelfFilter.setUseCoefficientTable(use);
+        highShelfFilter.setUseCoefficientTable(use);
+    }
+
+    /** ramp from the current coefficients to the pending targets over numSamples */
+    /**
+    \param numSamples length of the ramp in samples
+    */
+    void startCoefficientRamp(int numSamples)
+    {
+        coefficientRamp.start(numSamples);
+    }
+
+private:
+    /** take whatever the filters are designed to as both the current and the target coefficients (no ramp); after
+        a reset( ) these are the designs of the current parameters, so the next change still ramps from them */
+    void captureDesignedCoefficients()
+    {
+        coefficientRamp.capture(lowShelfFilter.getCoefficients(), highShelfFilter.getCoefficients());
+        updateCascade();
+    }
+
+    /** move the coefficients one sample along the ramp */
+    inline void advanceCoefficientRamp()
+    {
+        coefficientRamp.advance();
+        updateCascade();
+    }
+
+    /** put the current coefficients on the cascade lanes */
+    inline void updateCascade()
+    {
+        // --- stage 0 is the low shelf, stage 1 the high shelf
+        for (int stage = 0; stage < ShelvingCoefficientRamp::NUM_STAGES; stage++)
+            cascade.setStageCoefficients(stage, coefficientRamp.getCoefficients(stage));
+    }
+
+    TwoBandShelvingFilterParameters parameters; ///< object parameters
+    AudioFilter<T> lowShelfFilter;				///< designer for the low shelf
+    AudioFilter<T> highShelfFilter;				///< designer for the high shelf
+    StereoBiquadCascade<T> cascade;				///< both shelves on both channels
+
+    ShelvingCoefficientRamp coefficientRamp;	///< ramps the cascade from the running to the latest designs
+};
\ No newline at end of file
@@ -0,0 +1,79 @@
+// TripleBuffer.h
+
+#pragma once
+
+#include <atomic>
+
+/**
+\class TripleBuffer
+\ingroup FX-Objects
+\brief
+The TripleBuffer object hands complete copies of a value (e.g. a parameter structure) to one reader thread without
+locks or allocation: the writer fills its own slot and swaps it with the middle slot, the reader swaps its slot with
+the middle slot when the middle one holds new data. The reader never waits and always sees a whole, consistent value.
+
+Any number of threads may publish. Only one of them owns the writer slot at a time; a thread that finds it taken
+leaves a request and returns at once, and the owner fills and publishes again before it lets go. So the fill must
+build the value from the latest source data (e.g. the parameter atomics), not from anything passed by one caller.
+
+Control I/F:
+- Writers: publish( ) with a function that fills in the value.
+- Reader: update( ), then use getReadBuffer( ) until the next update( ).
+- Template parameter T is the value type; it must be copy-assignable.
+*/
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() {}		/* C-TOR */
+    ~TripleBuffer() {}		/* D-TOR */
+
+    /** writers: fill the writer slot and hand it to the reader; never waits for another writer */
+    /**
+    \param fill called as fill(T&) on the writer slot, which may hold an older value; must write all of it
+    */
+    template <typename Fill>
+    void publish(Fill&& fill)
+    {
+        publishRequested.store(true);
+
+        // --- a request left after the owner's last fill but before it let go is picked up by the outer loop
+        while (publishRequested.load() && !publishing.exchange(true))
+        {
+            while (publishRequested.exchange(false))
+            {
+                fill(buffers[writeIndex]);
+                writeIndex = middleIndex.exchange(writeIndex | NEW_DATA, std::memory_order_acq_rel) & INDEX_MASK;
+            }
+
+            publishing.store(false);
+        }
+    }
+
+    /** reader: take the latest published value, if there is one; only one atomic load when there is not */
+    /**
+    \return true if getReadBuffer( ) now holds a new value
+    */
+    bool update()
+    {
+        if ((middleIndex.load(std::memory_order_relaxed) & NEW_DATA) == 0)
+            return false;
+
+        readIndex = middleIndex.exchange(readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /** reader: the latest value taken by update( ) */
+    const T& getReadBuffer() const { return buffers[readIndex]; }
+
+private:
+    enum { INDEX_MASK = 3, NEW_DATA = 4 };
+
+    T buffers[3];							///< writer, middle and reader slots (in any order)
+    int writeIndex = 0;						///< slot owned by the writer
+    int readIndex = 2;						///< slot owned by the reader
+    std::atomic<int> middleIndex { 1 };		///< slot in between, plus the NEW_DATA flag
+
+    std::atomic<bool> publishing { false };			///< a writer owns writeIndex
+    std::atomic<bool> publishRequested { false };	///< a publish( ) is waiting for the owner to fill again
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "AudioFilter.h"
+#include "ShelvingCoefficientRamp.h"
 
 /**
 \class TwoBandShelvingFilter
@@ -15,13 +16,16 @@ Audio I/O:
 
 Control I/F:
 - Use TwoBandShelvingFilterParameters structure to get/set object params.
+- Template parameter T is the sample type (float or double); coefficients are designed and ramped in double,
+  by a ShelvingCoefficientRamp.
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
 \version Revision : 1.0
 \date Date : 2018 / 09 / 7
 */
-class TwoBandShelvingFilter : public IAudioSignalProcessor
+template <typename T>
+class TwoBandShelvingFilter : public IAudioSignalProcessor<T>
 {
 public:
     TwoBandShelvingFilter()
@@ -33,6 +37,8 @@ public:
         params = highShelfFilter.getParameters();
         params.algorithm = filterAlgorithm::kHiShelf;
         highShelfFilter.setParameters(params);
+
+        captureDesignedCoefficients();
     }		/* C-TOR */
 
     ~TwoBandShelvingFilter() {}		/* D-TOR */
@@ -42,9 +48,28 @@ public:
     {
         lowShelfFilter.reset(_sampleRate);
         highShelfFilter.reset(_sampleRate);
+
+        // --- the designs depend on the sample rate; they come from our parameters, since copyCoefficients( )
+        //     only copies the designed coefficients and leaves the filters' own parameters behind
+        lowShelfFilter.setSampleRate(_sampleRate);
+        highShelfFilter.setSampleRate(_sampleRate);
+        setFilterParameters();
+
+        captureDesignedCoefficients();
         return true;
     }
 
+    /** flush the filter states and finish any coefficient ramp; nothing is designed or allocated, so this is
+        safe to call from the audio thread (the sample rate and coefficient tables only change in reset( )) */
+    void flush()
+    {
+        lowShelfFilter.flush();
+        highShelfFilter.flush();
+
+        coefficientRamp.snapToTargets();
+        updateFilterCoefficients();
+    }
+
     /** return false: this object only processes samples */
     virtual bool canProcessAudioFrame() { return false; }
 
@@ -53,15 +78,52 @@ public:
     \param xn input
     \return the processed sample
     */
-    virtual double processAudioSample(double xn)
+    virtual T processAudioSample(T xn)
     {
+        // --- no block to ramp across: jump to any new coefficients
+        if (coefficientRamp.isTargetPending())
+            startCoefficientRamp(1);
+
+        if (coefficientRamp.isRamping())
+            advanceCoefficientRamp();
+
         // --- all modes do Full Wave Rectification
-        double filteredSignal = lowShelfFilter.processAudioSample(xn);
+        T filteredSignal = lowShelfFilter.processAudioSample(xn);
         filteredSignal = highShelfFilter.processAudioSample(filteredSignal);
 
         return filteredSignal;
     }
 
+    /** process a block of input through the two filters in series */
+    /**
+    \param input input samples
+    \param output output samples (may be the same buffer as input)
+    \param numSamples number of samples to process
+    */
+    virtual void processBlock(const T* input, T* output, int numSamples)
+    {
+        // --- ramp across this block unless the owner already started a (longer) ramp
+        if (coefficientRamp.isTargetPending())
+            startCoefficientRamp(numSamples);
+
+        // --- ramping section: coefficients move every sample
+        int i = 0;
+        for (; i < numSamples && coefficientRamp.isRamping(); i++)
+        {
+            advanceCoefficientRamp();
+
+            T filteredSignal = lowShelfFilter.processAudioSample(input[i]);
+            output[i] = highShelfFilter.processAudioSample(filteredSignal);
+        }
+
+        // --- steady section: coefficients are fixed
+        if (i < numSamples)
+        {
+            lowShelfFilter.processBlock(input + i, output + i, numSamples - i);
+            highShelfFilter.processBlock(output + i, output + i, numSamples - i);
+        }
+    }
+
     /** get parameters: note use of custom structure for passing param data */
     /**
     \return TwoBandShelvingFilterParameters custom data structure
@@ -73,11 +135,64 @@ public:
 
     /** set parameters: note use of custom structure for passing param data */
     /**
+    NOTE: the new coefficients are designed here (call this at control rate) and the filters
+          ramp to them linearly over the next processed block, or the length given to
+          startCoefficientRamp( ); first order shelves stay stable along a linear ramp
     \param TwoBandShelvingFilterParameters custom data structure
     */
     void setParameters(const TwoBandShelvingFilterParameters& params)
     {
+        if (params.lowShelf_fc == parameters.lowShelf_fc &&
+            params.lowShelfBoostCut_dB == parameters.lowShelfBoostCut_dB &&
+            params.highShelf_fc == parameters.highShelf_fc &&
+            params.highShelfBoostCut_dB == parameters.highShelfBoostCut_dB)
+            return;
+
         parameters = params;
+        setFilterParameters();
+
+        setTargetCoefficients(lowShelfFilter.getCoefficients(), highShelfFilter.getCoefficients());
+    }
+
+    /** share the coefficients already designed by another filter with the same parameters,
+        e.g. the other channel of a stereo pair, instead of designing them again */
+    /**
+    \param source filter whose parameters and target coefficients are copied
+    */
+    void copyCoefficients(const TwoBandShelvingFilter& source)
+    {
+        parameters = source.parameters;
+        setTargetCoefficients(source.coefficientRamp.getTargetCoefficients(ShelvingCoefficientRamp::LOW_SHELF),
+                              source.coefficientRamp.getTargetCoefficients(ShelvingCoefficientRamp::HIGH_SHELF));
+    }
+
+    /** look the shelf designs up in the shared coefficient tables instead of calculating them; takes effect at
+        the next reset( ), see AudioFilter::setUseCoefficientTable( ) */
+    /**
+    \param use true to use the tables
+    */
+    void setUseCoefficientTables(bool use)
+    {
+        lowShelfFilter.setUseCoefficientTable(use);
+        highShelfFilter.setUseCoefficientTable(use);
+    }
+
+    /** ramp from the current coefficients to the pending targets over numSamples */
+    /**
+    \param numSamples length of the ramp in samples
+    */
+    void startCoefficientRamp(int numSamples)
+    {
+        coefficientRamp.start(numSamples);
+    }
+
+private:
+    /** design the two filters for the current parameters (nothing is designed before the first setParameters( )) */
+    void setFilterParameters()
+    {
+        if (parameters.lowShelf_fc <= 0.0 || parameters.highShelf_fc <= 0.0)
+            return;
+
         AudioFilterParameters filterParams = lowShelfFilter.getParameters();
         filterParams.fc = parameters.lowShelf_fc;
         filterParams.boostCut_dB = parameters.lowShelfBoostCut_dB;
@@ -89,8 +204,37 @@ public:
         highShelfFilter.setParameters(filterParams);
     }
 
-private:
+    /** take whatever the filters are designed to as both the current and the target coefficients (no ramp); after
+        a reset( ) these are the designs of the current parameters, so the next change still ramps from them */
+    void captureDesignedCoefficients()
+    {
+        coefficientRamp.capture(lowShelfFilter.getCoefficients(), highShelfFilter.getCoefficients());
+    }
+
+    /** store new targets; the filters are put back on the current coefficients until the ramp runs */
+    void setTargetCoefficients(const double* lowShelfCoeffs, const double* highShelfCoeffs)
+    {
+        coefficientRamp.setTargets(lowShelfCoeffs, highShelfCoeffs);
+        updateFilterCoefficients();
+    }
+
+    /** move the coefficients one sample along the ramp */
+    inline void advanceCoefficientRamp()
+    {
+        coefficientRamp.advance();
+        updateFilterCoefficients();
+    }
+
+    /** put the current coefficients on the two filters */
+    inline void updateFilterCoefficients()
+    {
+        lowShelfFilter.setCoefficients(coefficientRamp.getCoefficients(ShelvingCoefficientRamp::LOW_SHELF));
+        highShelfFilter.setCoefficients(coefficientRamp.getCoefficients(ShelvingCoefficientRamp::HIGH_SHELF));
+    }
+
     TwoBandShelvingFilterParameters parameters; ///< object parameters
-    AudioFilter lowShelfFilter;					///< filter for low shelf
-    AudioFilter highShelfFilter;				///< filter for high shelf
+    AudioFilter<T> lowShelfFilter;				///< filter for low shelf
+    AudioFilter<T> highShelfFilter;				///< filter for high shelf
+
+    ShelvingCoefficientRamp coefficientRamp;	///< ramps the filters from the running to the latest designs
 };
\ No newline at end of file
@@ -13,6 +13,11 @@ const double kSqrtTwo = pow(2.0, 0.5);
 // --- constants for reverb tank
 const unsigned int NUM_BRANCHES = 4;
 const unsigned int NUM_CHANNELS = 2; // stereo
+const unsigned int TANK_BLOCK_SIZE = 64; // internal block size for ReverbTank::processBlock( ) scratch buffers
+const double MAX_SAMPLE_RATE = 192000.0; // ReverbTank reserves its delay memory for sample rates up to this
+
+// --- constants for modulation
+const unsigned int LFO_BLOCK_SIZE = 64; // max samples of LFO output rendered ahead by the modulated APFs
 
 // --- prevent accidental double inclusion
 #ifndef _guiconstants_h
@@ -37,13 +42,14 @@ returns interpolated value
 \param x - the interpolation location as a fractional distance between x1 and x2 (which are not needed)
 \return the interpolated value or y2 if the interpolation is outside the x interval
 */
-inline double doLinearInterpolation(double y1, double y2, double fractional_X)
+template <typename T>
+inline T doLinearInterpolation(T y1, T y2, T fractional_X)
 {
     // --- check invalid condition
-    if (fractional_X >= 1.0) return y2;
+    if (fractional_X >= (T)1.0) return y2;
 
     // --- use weighted sum method of interpolating
-    return fractional_X * y2 + (1.0 - fractional_X) * y1;
+    return fractional_X * y2 + ((T)1.0 - fractional_X) * y1;
 }
 
 /**
@@ -66,15 +72,16 @@ inline double doLinearInterpolation(double y1, double y2, double fractional_X)
 \param value - the value to check for underflow
 \return true if overflowed, false otherwise
 */
-inline bool checkFloatUnderflow(double& value)
+template <typename T>
+inline bool checkFloatUnderflow(T& value)
 {
     bool retValue = false;
-    if (value > 0.0 && value < kSmallestPositiveFloatValue)
+    if (value > (T)0.0 && value < (T)kSmallestPositiveFloatValue)
     {
         value = 0;
         retValue = true;
     }
-    else if (value < 0.0 && value > kSmallestNegativeFloatValue)
+    else if (value < (T)0.0 && value > (T)kSmallestNegativeFloatValue)
     {
         value = 0;
         retValue = true;
@@ -235,6 +242,16 @@ Use this strongly typed enum to easily set the oscillator waveform
 */
 enum class generatorWaveform { kTriangle, kSin, kSaw };
 
+/**
+\enum generatorOutput
+\ingroup Constants-Enums
+\brief
+Use this strongly typed enum to select one of the SignalGenData outputs, e.g. for LFO::renderBlock( )
+
+- enum class generatorOutput { kNormal, kInverted, kQuadPhasePos, kQuadPhaseNeg };
+*/
+enum class generatorOutput { kNormal, kInverted, kQuadPhasePos, kQuadPhaseNeg };
+
 /**
 \enum reverbDensity
 \ingroup Constants-Enums
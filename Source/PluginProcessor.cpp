@@ -22,10 +22,29 @@ JVerbAudioProcessor::JVerbAudioProcessor()
                        )
 #endif
 {
+    dryLevelParameter = apvts.getRawParameterValue("dryLevel_dB");
+    lowShelfBoostCutParameter = apvts.getRawParameterValue("lowShelfBoostCut_dB");
+    kRTParameter = apvts.getRawParameterValue("kRT");
+    highShelfBoostCutParameter = apvts.getRawParameterValue("highShelfBoostCut_dB");
+    wetLevelParameter = apvts.getRawParameterValue("wetLevel_dB");
+
+    apvts.addParameterListener("dryLevel_dB", this);
+    apvts.addParameterListener("lowShelfBoostCut_dB", this);
+    apvts.addParameterListener("kRT", this);
+    apvts.addParameterListener("highShelfBoostCut_dB", this);
+    apvts.addParameterListener("wetLevel_dB", this);
+
+    // --- the first set, for the first block
+    publishParameters();
 }
 
 JVerbAudioProcessor::~JVerbAudioProcessor()
 {
+    apvts.removeParameterListener("dryLevel_dB", this);
+    apvts.removeParameterListener("lowShelfBoostCut_dB", this);
+    apvts.removeParameterListener("kRT", this);
+    apvts.removeParameterListener("highShelfBoostCut_dB", this);
+    apvts.removeParameterListener("wetLevel_dB", this);
 }
 
 //==============================================================================
@@ -93,11 +112,19 @@ void JVerbAudioProcessor::changeProgramName (int index, const juce::String& newN
 //==============================================================================
 void JVerbAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    reverb.reset(sampleRate);
+    // --- the first reset reserves the delay memory for MAX_SAMPLE_RATE; later rate changes only re-slice it
+    if (isUsingDoublePrecision())
+        reverbDouble.reset(sampleRate);
+    else
+        reverbFloat.reset(sampleRate);
+
     dryGainParamSmoother.initializeSmoothing(50, sampleRate);
     lowGainParamSmoother.initializeSmoothing(50, sampleRate);
     highGainParamSmoother.initializeSmoothing(50, sampleRate);
     wetGainParamSmoother.initializeSmoothing(50, sampleRate);
+
+    // --- the tank and smoothers were reset, so push everything on the first block
+    forceParameterUpdate = true;
 }
 
 void JVerbAudioProcessor::releaseResources()
@@ -106,6 +133,15 @@ void JVerbAudioProcessor::releaseResources()
     // spare memory, etc.
 }
 
+void JVerbAudioProcessor::reset()
+{
+    // --- hosts may call this at any time, including from the audio thread: clear the tails, never reallocate
+    if (isUsingDoublePrecision())
+        reverbDouble.flush();
+    else
+        reverbFloat.flush();
+}
+
 #ifndef JucePlugin_PreferredChannelConfigurations
 bool JVerbAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
@@ -133,6 +169,17 @@ bool JVerbAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) co
 #endif
 
 void JVerbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples(buffer, reverbFloat);
+}
+
+void JVerbAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples(buffer, reverbDouble);
+}
+
+template <typename SampleType>
+void JVerbAudioProcessor::processSamples (juce::AudioBuffer<SampleType>& buffer, ReverbTankSIMD<SampleType>& reverb)
 {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels = getTotalNumInputChannels();
@@ -141,20 +188,33 @@ void JVerbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    auto* leftChannelData = buffer.getWritePointer(0);
-    auto* rightChannelData = buffer.getWritePointer(1);
+    auto numChannels = juce::jmin(totalNumOutputChannels, (int)NUM_CHANNELS);
+    auto numSamples = buffer.getNumSamples();
+    auto interval = controlRateInterval.load();
+    SampleType* channelData[NUM_CHANNELS] = { nullptr };
+
+    // --- take the latest parameter set, if one was published since the last block: one atomic load when
+    //     nothing changed, and the whole set is swapped in at once so a block never mixes old and new values
+    if (parameterSnapshots.update())
+        forceParameterUpdate = true;
 
-    for (int i = 0; i < buffer.getNumSamples(); i++)
+    // --- run the reverb in control-rate sub-blocks; the tank is only reconfigured when the parameters
+    //     changed or a smoother is still moving, the tank ramps the dry/wet gains across each sub-block
+    //     at audio rate
+    for (int offset = 0; offset < numSamples; offset += interval)
     {
-        updateParameters();
+        auto subBlockSize = juce::jmin(interval, numSamples - offset);
 
-        float inputFrame[2]{ leftChannelData[i], rightChannelData[i] };
-        float outputFrame[2] { 0.0, 0.0 };
+        if (forceParameterUpdate || isSmoothingParameters())
+        {
+            forceParameterUpdate = false;
+            updateParameters(reverb, subBlockSize);
+        }
 
-        reverb.processAudioFrame(inputFrame, outputFrame, totalNumInputChannels, totalNumOutputChannels);
+        for (int ch = 0; ch < numChannels; ch++)
+            channelData[ch] = buffer.getWritePointer(ch, offset);
 
-        buffer.setSample(0, i, outputFrame[0]);
-        buffer.setSample(1, i, outputFrame[1]);
+        reverb.processBlock(channelData, channelData, numChannels, subBlockSize);
     }
 }
 
@@ -227,25 +287,50 @@ juce::AudioProcessorValueTreeState::ParameterLayout JVerbAudioProcessor::createP
 }
 
 //==============================================================================
-void JVerbAudioProcessor::updateParameters()
+template <typename SampleType>
+void JVerbAudioProcessor::updateParameters(ReverbTankSIMD<SampleType>& reverb, int numSamples)
 {
-    ReverbTankParameters params = reverb.getParameters();
+    // --- the latest published set; the levels are smoothed towards it
+    ReverbTankParameters params = parameterSnapshots.getReadBuffer();
 
-    params.dryLevel_dB = *apvts.getRawParameterValue("dryLevel_dB");
-    params.dryLevel_dB = dryGainParamSmoother.processSmoothing(params.dryLevel_dB);
+    params.dryLevel_dB = dryGainParamSmoother.processSmoothing(params.dryLevel_dB, numSamples);
+    params.lowShelfBoostCut_dB = lowGainParamSmoother.processSmoothing(params.lowShelfBoostCut_dB, numSamples);
+    params.highShelfBoostCut_dB = highGainParamSmoother.processSmoothing(params.highShelfBoostCut_dB, numSamples);
+    params.wetLevel_dB = wetGainParamSmoother.processSmoothing(params.wetLevel_dB, numSamples);
 
-    params.lowShelfBoostCut_dB = *apvts.getRawParameterValue("lowShelfBoostCut_dB");
-    params.lowShelfBoostCut_dB = lowGainParamSmoother.processSmoothing(params.lowShelfBoostCut_dB);
+    reverb.setParameters(params);
+}
 
-    params.kRT = *apvts.getRawParameterValue("kRT");
+void JVerbAudioProcessor::setControlRateInterval(int numSamples)
+{
+    controlRateInterval = juce::jmax(1, numSamples);
+}
 
-    params.highShelfBoostCut_dB = *apvts.getRawParameterValue("highShelfBoostCut_dB");
-    params.highShelfBoostCut_dB = highGainParamSmoother.processSmoothing(params.highShelfBoostCut_dB);
+void JVerbAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    // --- may be called from any thread, including the audio thread under host automation; the audio
+    //     thread picks the new set up at the start of its next block
+    publishParameters();
+}
 
-    params.wetLevel_dB = *apvts.getRawParameterValue("wetLevel_dB");
-    params.wetLevel_dB = wetGainParamSmoother.processSmoothing(params.wetLevel_dB);
+void JVerbAudioProcessor::publishParameters()
+{
+    // --- no locks and no allocation: if another thread is publishing, it builds the set again for us
+    parameterSnapshots.publish([this](ReverbTankParameters& params)
+    {
+        // --- the slot may hold an older set: every parameter the apvts owns is written again
+        params.dryLevel_dB = dryLevelParameter->load();
+        params.lowShelfBoostCut_dB = lowShelfBoostCutParameter->load();
+        params.kRT = kRTParameter->load();
+        params.highShelfBoostCut_dB = highShelfBoostCutParameter->load();
+        params.wetLevel_dB = wetLevelParameter->load();
+    });
+}
 
-    reverb.setParameters(params);
+bool JVerbAudioProcessor::isSmoothingParameters() const
+{
+    return dryGainParamSmoother.isSmoothing() || lowGainParamSmoother.isSmoothing() ||
+           highGainParamSmoother.isSmoothing() || wetGainParamSmoother.isSmoothing();
 }
 
 //==============================================================================
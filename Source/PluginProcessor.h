@@ -11,11 +11,13 @@
 #include <JuceHeader.h>
 #include "DSP/ReverbTank.h"
 #include "DSP/ParamSmoother.h"
+#include "DSP/TripleBuffer.h"
 
 class ParamSmoother;
 
 //==============================================================================
-class JVerbAudioProcessor  : public juce::AudioProcessor
+class JVerbAudioProcessor  : public juce::AudioProcessor,
+                             private juce::AudioProcessorValueTreeState::Listener
 {
 public:
     //==============================================================================
@@ -25,12 +27,17 @@ public:
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void reset() override;
 
    #ifndef JucePlugin_PreferredChannelConfigurations
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    // --- the DSP runs in whichever precision the host asks for
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -59,11 +66,40 @@ public:
 
     juce::AudioProcessorValueTreeState apvts{ *this, nullptr, "Parameters", createParameterLayout() };
 
+    // --- parameters are pulled from the apvts at most once per control block of this many samples
+    void setControlRateInterval(int numSamples);
+    int getControlRateInterval() const { return controlRateInterval.load(); }
+
 protected:
-    ReverbTank reverb;
-    void updateParameters();
+    // --- one tank per sample type; only the one matching the host's precision is reset and run
+    ReverbTankSIMD<float> reverbFloat;
+    ReverbTankSIMD<double> reverbDouble;
+
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer, ReverbTankSIMD<SampleType>& reverb);
+
+    template <typename SampleType>
+    void updateParameters(ReverbTankSIMD<SampleType>& reverb, int numSamples);
 
 private:
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    void publishParameters();
+    bool isSmoothingParameters() const;
+
+    std::atomic<int> controlRateInterval { 32 };
+
+    // --- the apvts values, looked up once and read only by publishParameters( )
+    std::atomic<float>* dryLevelParameter = nullptr;
+    std::atomic<float>* lowShelfBoostCutParameter = nullptr;
+    std::atomic<float>* kRTParameter = nullptr;
+    std::atomic<float>* highShelfBoostCutParameter = nullptr;
+    std::atomic<float>* wetLevelParameter = nullptr;
+
+    // --- complete parameter sets, published by whichever thread changed a parameter and picked up by the
+    //     audio thread once per block; neither side takes a lock
+    TripleBuffer<ReverbTankParameters> parameterSnapshots;
+    bool forceParameterUpdate = true;
+
     ParamSmoother dryGainParamSmoother,
                   lowGainParamSmoother,
                   highGainParamSmoother,
@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+    Benchmark.cpp
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include <iostream>
+
+//==============================================================================
+namespace
+{
+    // --- the noise repeats after this many samples; several of the largest blocks, so consecutive
+    //     blocks see different input
+    const int kNoiseLength = 1 << 15;
+
+    std::atomic<double> benchmarkSink { 0.0 };
+
+    juce::String getCompilerDescription()
+    {
+       #if JUCE_CLANG
+        return "clang " __clang_version__;
+       #elif JUCE_GCC
+        return "gcc " __VERSION__;
+       #elif JUCE_MSVC
+        return "msvc " + juce::String(_MSC_FULL_VER);
+       #else
+        return "unknown";
+       #endif
+    }
+}
+
+void consumeBenchmarkOutput(double value)
+{
+    benchmarkSink.store(value, std::memory_order_relaxed);
+}
+
+//==============================================================================
+template <typename SampleType>
+BlockTimer<SampleType>::BlockTimer(const BenchmarkSettings& _settings)
+    : settings(_settings), noiseLength(kNoiseLength)
+{
+    juce::Random random((juce::int64)settings.seed);
+    noise.allocate((size_t)noiseLength, false);
+    for (int i = 0; i < noiseLength; i++)
+        noise[i] = (SampleType)(random.nextDouble() - 0.5);
+
+    int maxBlockSize = 1;
+    for (auto blockSize : settings.blockSizes)
+        maxBlockSize = juce::jmax(maxBlockSize, blockSize);
+
+    output.allocate((size_t)maxBlockSize, true);
+}
+
+template <typename SampleType>
+void BlockTimer<SampleType>::measure(const ProcessFunction& process, int blockSize, BenchmarkResult& result)
+{
+    jassert(blockSize <= noiseLength);
+    result.blockSize = blockSize;
+
+    auto runOnce = [&]
+    {
+        int position = 0;
+        for (int done = 0; done < settings.numSamples; done += blockSize)
+        {
+            int numSamples = juce::jmin(blockSize, settings.numSamples - done);
+            if (position + numSamples > noiseLength)
+                position = 0;
+
+            process(noise + position, output, numSamples);
+            consumeBenchmarkOutput((double)output[numSamples - 1]);
+            position += numSamples;
+        }
+    };
+
+    // --- warm up the caches and branch predictors, then time
+    runOnce();
+
+    juce::Array<double> times_Sec;
+    for (int repeat = 0; repeat < juce::jmax(1, settings.numRepeats); repeat++)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        runOnce();
+        times_Sec.add(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+    }
+
+    times_Sec.sort();
+    result.nsPerSample = times_Sec.getFirst() * 1.0e9 / settings.numSamples;
+    result.nsPerSampleMedian = times_Sec[times_Sec.size() / 2] * 1.0e9 / settings.numSamples;
+    result.samplesPerSecond = settings.numSamples / juce::jmax(times_Sec.getFirst(), 1.0e-12);
+}
+
+// --- the sample types the DSP objects are built for
+template class BlockTimer<float>;
+template class BlockTimer<double>;
+
+//==============================================================================
+BenchmarkReport::BenchmarkReport(const juce::String& _mode, const BenchmarkSettings& _settings)
+    : mode(_mode), settings(_settings)
+{
+}
+
+void BenchmarkReport::add(const BenchmarkResult& result)
+{
+    results.add(result);
+
+    std::cout << juce::String::formatted("%-44s %6.0f Hz %5d  %9.2f ns/sample  %8.2f Msamples/s  %7.1fx real time",
+        result.name.toRawUTF8(), result.sampleRate, result.blockSize, result.nsPerSample,
+        result.samplesPerSecond * 1.0e-6, result.samplesPerSecond / result.sampleRate) << std::endl;
+}
+
+juce::var BenchmarkReport::toVar() const
+{
+    auto* system = new juce::DynamicObject();
+    system->setProperty("cpu", juce::SystemStats::getCpuModel());
+    system->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    system->setProperty("numPhysicalCpus", juce::SystemStats::getNumPhysicalCpus());
+    system->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    system->setProperty("juce", juce::SystemStats::getJUCEVersion());
+    system->setProperty("compiler", getCompilerDescription());
+   #if JUCE_DEBUG
+    system->setProperty("build", "Debug");
+   #else
+    system->setProperty("build", "Release");
+   #endif
+
+    juce::Array<juce::var> sampleRates, blockSizes;
+    for (auto sampleRate : settings.sampleRates)
+        sampleRates.add(sampleRate);
+    for (auto blockSize : settings.blockSizes)
+        blockSizes.add(blockSize);
+
+    auto* benchSettings = new juce::DynamicObject();
+    benchSettings->setProperty("sampleRates", sampleRates);
+    benchSettings->setProperty("blockSizes", blockSizes);
+    benchSettings->setProperty("numSamples", settings.numSamples);
+    benchSettings->setProperty("numRepeats", settings.numRepeats);
+    benchSettings->setProperty("sampleType", settings.useDoublePrecision ? "double" : "float");
+    benchSettings->setProperty("seed", (juce::int64)settings.seed);
+    if (settings.filter.isNotEmpty())
+        benchSettings->setProperty("filter", settings.filter);
+
+    if (mode == "instances")
+    {
+        juce::Array<juce::var> instanceCounts;
+        for (auto numInstances : settings.instanceCounts)
+            instanceCounts.add(numInstances);
+
+        benchSettings->setProperty("instanceCounts", instanceCounts);
+        benchSettings->setProperty("numThreads", settings.numThreads > 0 ? settings.numThreads
+                                                                         : juce::SystemStats::getNumPhysicalCpus());
+    }
+
+    juce::Array<juce::var> resultList;
+    for (auto& result : results)
+    {
+        auto* item = new juce::DynamicObject();
+        item->setProperty("name", result.name);
+        item->setProperty("sampleRate", result.sampleRate);
+        item->setProperty("blockSize", result.blockSize);
+        item->setProperty("numChannels", result.numChannels);
+        item->setProperty("nsPerSample", result.nsPerSample);
+        item->setProperty("nsPerSampleMedian", result.nsPerSampleMedian);
+        item->setProperty("samplesPerSecond", result.samplesPerSecond);
+        item->setProperty("realTimeFactor", result.samplesPerSecond / result.sampleRate);
+
+        for (auto& value : result.extra)
+            item->setProperty(value.name, value.value);
+
+        resultList.add(item);
+    }
+
+    auto* report = new juce::DynamicObject();
+    report->setProperty("tool", "JVerbBench");
+    report->setProperty("formatVersion", 1);
+    report->setProperty("mode", mode);
+    report->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    report->setProperty("system", system);
+    report->setProperty("settings", benchSettings);
+    report->setProperty("results", resultList);
+
+    return report;
+}
+
+juce::Result BenchmarkReport::writeJSON(const juce::File& file) const
+{
+    if (!file.replaceWithText(juce::JSON::toString(toVar())))
+        return juce::Result::fail("cannot write " + file.getFullPathName());
+
+    return juce::Result::ok();
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    Benchmark.h
+    Timing harness and JSON report shared by the JVerbBench modes.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** What to measure; every mode runs the same grid of sample rates and block sizes */
+struct BenchmarkSettings
+{
+    juce::Array<double> sampleRates { 44100.0, 48000.0, 96000.0, 192000.0 };
+    juce::Array<int> blockSizes { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+
+    int numSamples = 1 << 16;       // samples processed per timed run
+    int numRepeats = 5;             // timed runs per measurement, after one warm-up run
+    bool useDoublePrecision = false;
+    juce::String filter;            // only run benchmarks whose name contains this
+    juce::uint32 seed = 0x4a566572; // input noise seed, so every run sees the same signal
+
+    // --- the --instances mode only
+    juce::Array<int> instanceCounts { 1, 2, 4, 8, 16, 32, 48, 64 };
+    int numThreads = 0;             // render pool threads; 0: one per physical core
+};
+
+//==============================================================================
+/** One measurement: the fastest and the median of the timed runs */
+struct BenchmarkResult
+{
+    juce::String name;              // object/variant, e.g. "Biquad/kDirect"
+    double sampleRate = 0.0;
+    int blockSize = 0;
+    int numChannels = 1;
+
+    double nsPerSample = 0.0;       // fastest run
+    double nsPerSampleMedian = 0.0;
+    double samplesPerSecond = 0.0;  // from the fastest run, per channel
+
+    /** extra figures a mode wants in the report (e.g. block time percentiles) */
+    juce::NamedValueSet extra;
+};
+
+//==============================================================================
+/**
+    Times a block process function: numSamples samples of seeded white noise are run through it in
+    blocks of blockSize, numRepeats times after one warm-up run. The process function gets the input
+    and output block and must not keep pointers to them.
+*/
+template <typename SampleType>
+class BlockTimer
+{
+public:
+    using ProcessFunction = std::function<void(const SampleType* input, SampleType* output, int numSamples)>;
+
+    BlockTimer(const BenchmarkSettings& settings);
+
+    /** run the measurement; fills in the timing fields of result */
+    void measure(const ProcessFunction& process, int blockSize, BenchmarkResult& result);
+
+private:
+    const BenchmarkSettings& settings;
+    juce::HeapBlock<SampleType> noise;
+    juce::HeapBlock<SampleType> output;
+    int noiseLength = 0;
+};
+
+//==============================================================================
+/** Collects results, prints them as a table while they come in and writes them all as JSON */
+class BenchmarkReport
+{
+public:
+    BenchmarkReport(const juce::String& mode, const BenchmarkSettings& settings);
+
+    void add(const BenchmarkResult& result);
+
+    /** the whole report, with the system and settings it was measured with */
+    juce::var toVar() const;
+
+    juce::Result writeJSON(const juce::File& file) const;
+
+private:
+    juce::String mode;
+    const BenchmarkSettings& settings;
+    juce::Array<BenchmarkResult> results;
+};
+
+//==============================================================================
+/** keeps a value alive so the optimizer cannot drop the work that produced it */
+void consumeBenchmarkOutput(double value);
@@ -0,0 +1,431 @@
+/*
+  ==============================================================================
+
+    DSPBenchmarks.cpp
+
+  ==============================================================================
+*/
+
+#include "DSPBenchmarks.h"
+#include "../../../Source/DSP/ReverbTank.h"
+#include "../../../Source/DSP/TwoBandShelvingFilter.h"
+
+//==============================================================================
+namespace
+{
+    const char* const kBiquadAlgorithmNames[] =
+    {
+        "kDirect", "kCanonical", "kTransposeDirect", "kTransposeCanonical"
+    };
+
+    const char* const kFilterAlgorithmNames[] =
+    {
+        "kLPF1P", "kLPF1", "kHPF1", "kLPF2", "kHPF2", "kBPF2", "kBSF2", "kButterLPF2", "kButterHPF2", "kButterBPF2",
+        "kButterBSF2", "kMMALPF2", "kMMALPF2B", "kLowShelf", "kHiShelf", "kNCQParaEQ", "kCQParaEQ", "kLWRLPF2", "kLWRHPF2",
+        "kAPF1", "kAPF2", "kResonA", "kResonB", "kMatchLP2A", "kMatchLP2B", "kMatchBP2A", "kMatchBP2B",
+        "kImpInvLP1", "kImpInvLP2"
+    };
+
+    // --- delay line settings shared by the delay benchmarks
+    const double kBufferLength_mSec = 100.0;
+    const double kReadDelay_mSec = 50.0;
+    const double kReadFraction = 0.37;
+
+    // --- automated benchmarks change their parameters this often, like the plug-in's control rate
+    const int kAutomationInterval = 32;
+
+    //==============================================================================
+    /** a benchmark: prepare( ) makes a freshly reset object for a sample rate and returns its process function */
+    template <typename SampleType>
+    struct DSPBenchmark
+    {
+        juce::String name;
+        std::function<typename BlockTimer<SampleType>::ProcessFunction(double sampleRate)> prepare;
+        int numChannels = 1;
+    };
+
+    //==============================================================================
+    template <typename SampleType>
+    void addFilterBenchmarks(std::vector<DSPBenchmark<SampleType>>& benchmarks)
+    {
+        // --- the bare biquad, with a 1 kHz Butterworth LPF designed by an AudioFilter
+        for (int i = 0; i < juce::numElementsInArray(kBiquadAlgorithmNames); i++)
+        {
+            benchmarks.push_back({ juce::String("Biquad/") + kBiquadAlgorithmNames[i], [i](double sampleRate)
+            {
+                AudioFilter<SampleType> design;
+                design.reset(sampleRate);
+                AudioFilterParameters filterParams = design.getParameters();
+                filterParams.algorithm = filterAlgorithm::kButterLPF2;
+                filterParams.fc = 1000.0;
+                design.setParameters(filterParams);
+
+                auto biquad = std::make_shared<Biquad<SampleType>>();
+                BiquadParameters biquadParams = biquad->getParameters();
+                biquadParams.biquadCalcType = (biquadAlgorithm)i;
+                biquad->setParameters(biquadParams);
+                biquad->setCoefficients(design.getCoefficients());
+                biquad->reset(sampleRate);
+
+                return [biquad](const SampleType* input, SampleType* output, int numSamples)
+                {
+                    biquad->processBlock(input, output, numSamples);
+                };
+            } });
+        }
+
+        // --- every filter design at 1 kHz, -6 dB where it has a gain
+        for (int i = 0; i < juce::numElementsInArray(kFilterAlgorithmNames); i++)
+        {
+            benchmarks.push_back({ juce::String("AudioFilter/") + kFilterAlgorithmNames[i], [i](double sampleRate)
+            {
+                auto filter = std::make_shared<AudioFilter<SampleType>>();
+                filter->reset(sampleRate);
+                AudioFilterParameters filterParams = filter->getParameters();
+                filterParams.algorithm = (filterAlgorithm)i;
+                filterParams.fc = 1000.0;
+                filterParams.Q = 0.707;
+                filterParams.boostCut_dB = -6.0;
+                filter->setParameters(filterParams);
+
+                return [filter](const SampleType* input, SampleType* output, int numSamples)
+                {
+                    filter->processBlock(input, output, numSamples);
+                };
+            } });
+        }
+
+        // --- both shelves with their gains moving every kAutomationInterval samples, designed by the
+        //     formulas and looked up in the coefficient tables
+        for (int useTables = 0; useTables < 2; useTables++)
+        {
+            benchmarks.push_back({ useTables ? "TwoBandShelvingFilter/automatedTables" : "TwoBandShelvingFilter/automated", [useTables](double sampleRate)
+            {
+                auto filter = std::make_shared<TwoBandShelvingFilter<SampleType>>();
+                filter->setUseCoefficientTables(useTables != 0);
+                filter->reset(sampleRate);
+                auto step = std::make_shared<int>(0);
+
+                return [filter, step](const SampleType* input, SampleType* output, int numSamples)
+                {
+                    for (int offset = 0; offset < numSamples; offset += kAutomationInterval)
+                    {
+                        // --- sweep the gains across the plug-in's range, 0.01 dB at a time
+                        double position = (*step)++ % 4000 * 0.01;
+
+                        TwoBandShelvingFilterParameters params = filter->getParameters();
+                        params.lowShelfBoostCut_dB = -20.0 + position;
+                        params.highShelfBoostCut_dB = 20.0 - position;
+                        filter->setParameters(params);
+
+                        int blockSize = juce::jmin(kAutomationInterval, numSamples - offset);
+                        filter->processBlock(input + offset, output + offset, blockSize);
+                    }
+                };
+            } });
+        }
+    }
+
+    //==============================================================================
+    /** the tank's output shelving on a stereo pair: two TwoBandShelvingFilters, one per channel, and the
+        StereoShelvingFilter running both channels and both shelves in SIMD lanes */
+    template <typename SampleType>
+    void addStereoShelvingBenchmarks(std::vector<DSPBenchmark<SampleType>>& benchmarks)
+    {
+        TwoBandShelvingFilterParameters shelvingParams;
+        shelvingParams.lowShelf_fc = 150.0;
+        shelvingParams.lowShelfBoostCut_dB = -6.0;
+        shelvingParams.highShelf_fc = 4000.0;
+        shelvingParams.highShelfBoostCut_dB = -12.0;
+
+        DSPBenchmark<SampleType> pair = { "TwoBandShelvingFilter/stereoPair", [shelvingParams](double sampleRate)
+        {
+            auto filters = std::make_shared<std::vector<TwoBandShelvingFilter<SampleType>>>(NUM_CHANNELS);
+            for (auto& filter : *filters)
+            {
+                filter.reset(sampleRate);
+                filter.setParameters(shelvingParams);
+            }
+
+            // --- the right channel's output goes here
+            auto right = std::make_shared<std::vector<SampleType>>();
+
+            return [filters, right](const SampleType* input, SampleType* output, int numSamples)
+            {
+                if ((int)right->size() < numSamples)
+                    right->resize((size_t)numSamples);
+
+                (*filters)[0].processBlock(input, output, numSamples);
+                (*filters)[1].processBlock(input, right->data(), numSamples);
+            };
+        } };
+
+        DSPBenchmark<SampleType> stereo = { "StereoShelvingFilter", [shelvingParams](double sampleRate)
+        {
+            auto filter = std::make_shared<StereoShelvingFilter<SampleType>>();
+            filter->reset(sampleRate);
+            filter->setParameters(shelvingParams);
+
+            // --- the right channel's output goes here
+            auto right = std::make_shared<std::vector<SampleType>>();
+
+            return [filter, right](const SampleType* input, SampleType* output, int numSamples)
+            {
+                if ((int)right->size() < numSamples)
+                    right->resize((size_t)numSamples);
+
+                // --- the filter runs in place
+                std::copy(input, input + numSamples, output);
+                std::copy(input, input + numSamples, right->data());
+                filter->processBlock(output, right->data(), numSamples);
+            };
+        } };
+
+        pair.numChannels = NUM_CHANNELS;
+        stereo.numChannels = NUM_CHANNELS;
+        benchmarks.push_back(pair);
+        benchmarks.push_back(stereo);
+    }
+
+    //==============================================================================
+    /** one write and one (interpolated) read per sample, like a delay line */
+    template <typename SampleType, template <typename, template <typename> class> class Storage, template <typename> class Interpolator>
+    DSPBenchmark<SampleType> makeReadBenchmark(const juce::String& name, bool interpolate)
+    {
+        return { name, [interpolate](double sampleRate)
+        {
+            auto buffer = std::make_shared<Storage<SampleType, Interpolator>>();
+            buffer->createCircularBuffer((unsigned int)(kBufferLength_mSec * sampleRate / 1000.0));
+            buffer->setInterpolate(interpolate);
+            double delay = kReadDelay_mSec * sampleRate / 1000.0 + kReadFraction;
+
+            return [buffer, delay](const SampleType* input, SampleType* output, int numSamples)
+            {
+                for (int i = 0; i < numSamples; i++)
+                {
+                    output[i] = buffer->readBuffer(delay);
+                    buffer->writeBuffer(input[i]);
+                }
+            };
+        } };
+    }
+
+    /** writeBlock( ) then readBlock( ) */
+    template <typename SampleType, template <typename, template <typename> class> class Storage>
+    DSPBenchmark<SampleType> makeReadBlockBenchmark(const juce::String& name)
+    {
+        return { name, [](double sampleRate)
+        {
+            auto buffer = std::make_shared<Storage<SampleType, LinearInterpolator>>();
+            buffer->createCircularBuffer((unsigned int)(kBufferLength_mSec * sampleRate / 1000.0));
+            buffer->setInterpolate(true);
+            double delay = kReadDelay_mSec * sampleRate / 1000.0 + kReadFraction;
+
+            return [buffer, delay](const SampleType* input, SampleType* output, int numSamples)
+            {
+                buffer->writeBlock(input, numSamples);
+                buffer->readBlock(delay, output, numSamples);
+            };
+        } };
+    }
+
+    template <typename SampleType>
+    void addDelayBufferBenchmarks(std::vector<DSPBenchmark<SampleType>>& benchmarks)
+    {
+        benchmarks.push_back(makeReadBenchmark<SampleType, CircularBuffer, LinearInterpolator>("CircularBuffer/readInteger", false));
+        benchmarks.push_back(makeReadBenchmark<SampleType, CircularBuffer, LinearInterpolator>("CircularBuffer/readLinear", true));
+        benchmarks.push_back(makeReadBenchmark<SampleType, CircularBuffer, Lagrange3Interpolator>("CircularBuffer/readLagrange3", true));
+        benchmarks.push_back(makeReadBenchmark<SampleType, CircularBuffer, HermiteInterpolator>("CircularBuffer/readHermite", true));
+        benchmarks.push_back(makeReadBenchmark<SampleType, CircularBuffer, AllpassInterpolator>("CircularBuffer/readAllpass", true));
+        benchmarks.push_back(makeReadBlockBenchmark<SampleType, CircularBuffer>("CircularBuffer/readBlockLinear"));
+        benchmarks.push_back(makeReadBenchmark<SampleType, MirroredCircularBuffer, LinearInterpolator>("MirroredCircularBuffer/readLinear", true));
+        benchmarks.push_back(makeReadBenchmark<SampleType, MirroredCircularBuffer, HermiteInterpolator>("MirroredCircularBuffer/readHermite", true));
+        benchmarks.push_back(makeReadBlockBenchmark<SampleType, MirroredCircularBuffer>("MirroredCircularBuffer/readBlockLinear"));
+    }
+
+    //==============================================================================
+    /** static, modulated at audio rate or modulated at control rate (the reverb tank's settings) */
+    enum class apfModulation { kStatic, kAudioRate, kControlRate };
+
+    const char* getModulationName(apfModulation modulation)
+    {
+        return modulation == apfModulation::kStatic ? "static" : modulation == apfModulation::kAudioRate ? "modulated" : "modulatedControlRate";
+    }
+
+    template <typename SampleType>
+    void addAPFBenchmarks(std::vector<DSPBenchmark<SampleType>>& benchmarks)
+    {
+        for (auto modulation : { apfModulation::kStatic, apfModulation::kAudioRate, apfModulation::kControlRate })
+        {
+            benchmarks.push_back({ juce::String("DelayAPF/") + getModulationName(modulation), [modulation](double sampleRate)
+            {
+                auto apf = std::make_shared<DelayAPF<SampleType>>();
+                apf->createDelayBuffer(sampleRate, kBufferLength_mSec);
+                apf->reset(sampleRate);
+
+                DelayAPFParameters params = apf->getParameters();
+                params.delayTime_mSec = 20.0;
+                params.apf_g = 0.6;
+                params.enableLFO = modulation != apfModulation::kStatic;
+                params.interpolate = params.enableLFO;
+                params.lfoRate_Hz = 0.15;
+                params.lfoDepth = 1.0;
+                params.lfoMaxModulation_mSec = 0.3;
+                params.lfoUpdateInterval = modulation == apfModulation::kControlRate ? kReverbTankLFOUpdateInterval : 1;
+                apf->setParameters(params);
+
+                return [apf](const SampleType* input, SampleType* output, int numSamples)
+                {
+                    apf->processBlock(input, output, numSamples);
+                };
+            } });
+
+            benchmarks.push_back({ juce::String("NestedDelayAPF/") + getModulationName(modulation), [modulation](double sampleRate)
+            {
+                auto apf = std::make_shared<NestedDelayAPF<SampleType>>();
+                apf->createDelayBuffers(sampleRate, kBufferLength_mSec, kBufferLength_mSec);
+                apf->reset(sampleRate);
+
+                NestedDelayAPFParameters params = apf->getParameters();
+                params.outerAPFdelayTime_mSec = 20.0;
+                params.innerAPFdelayTime_mSec = 12.0;
+                params.outerAPF_g = -0.5;
+                params.innerAPF_g = 0.5;
+                params.enableLFO = modulation != apfModulation::kStatic;
+                params.lfoRate_Hz = 0.15;
+                params.lfoDepth = 1.0;
+                params.lfoMaxModulation_mSec = 0.3;
+                params.lfoUpdateInterval = modulation == apfModulation::kControlRate ? kReverbTankLFOUpdateInterval : 1;
+                apf->setParameters(params);
+
+                return [apf](const SampleType* input, SampleType* output, int numSamples)
+                {
+                    apf->processBlock(input, output, numSamples);
+                };
+            } });
+        }
+    }
+
+    //==============================================================================
+    std::shared_ptr<LFO> makeLFO(double sampleRate)
+    {
+        auto lfo = std::make_shared<LFO>();
+        lfo->reset(sampleRate);
+
+        OscillatorParameters params = lfo->getParameters();
+        params.frequency_Hz = 0.5;
+        params.waveform = generatorWaveform::kSin;
+        lfo->setParameters(params);
+        return lfo;
+    }
+
+    template <typename SampleType>
+    void addLFOBenchmarks(std::vector<DSPBenchmark<SampleType>>& benchmarks)
+    {
+        benchmarks.push_back({ "LFO/renderAudioOutput", [](double sampleRate)
+        {
+            auto lfo = makeLFO(sampleRate);
+            return [lfo](const SampleType*, SampleType* output, int numSamples)
+            {
+                for (int i = 0; i < numSamples; i++)
+                    output[i] = (SampleType)lfo->renderAudioOutput().normalOutput;
+            };
+        } });
+
+        benchmarks.push_back({ "LFO/renderBlock", [](double sampleRate)
+        {
+            auto lfo = makeLFO(sampleRate);
+            return [lfo](const SampleType*, SampleType* output, int numSamples)
+            {
+                lfo->renderBlock(output, numSamples);
+            };
+        } });
+    }
+
+    //==============================================================================
+    /** the whole tank, stereo out from a mono-ized stereo input */
+    template <typename SampleType, typename Tank>
+    DSPBenchmark<SampleType> makeTankBenchmark(const juce::String& name, reverbDensity density)
+    {
+        DSPBenchmark<SampleType> benchmark { name, [density](double sampleRate)
+        {
+            auto reverb = std::make_shared<Tank>();
+            reverb->reset(sampleRate);
+
+            ReverbTankParameters params = reverb->getParameters();
+            params.density = density;
+            reverb->setParameters(params);
+
+            // --- the right channel's output goes here
+            auto right = std::make_shared<std::vector<SampleType>>();
+
+            return [reverb, right](const SampleType* input, SampleType* output, int numSamples)
+            {
+                if ((int)right->size() < numSamples)
+                    right->resize((size_t)numSamples);
+
+                const SampleType* inputs[NUM_CHANNELS] = { input, input };
+                SampleType* outputs[NUM_CHANNELS] = { output, right->data() };
+                reverb->processBlock(inputs, outputs, NUM_CHANNELS, numSamples);
+            };
+        } };
+
+        benchmark.numChannels = NUM_CHANNELS;
+        return benchmark;
+    }
+
+    template <typename SampleType>
+    void addTankBenchmarks(std::vector<DSPBenchmark<SampleType>>& benchmarks)
+    {
+        benchmarks.push_back(makeTankBenchmark<SampleType, ReverbTank<SampleType>>("ReverbTank/thick", reverbDensity::kThick));
+        benchmarks.push_back(makeTankBenchmark<SampleType, ReverbTank<SampleType>>("ReverbTank/sparse", reverbDensity::kSparse));
+        benchmarks.push_back(makeTankBenchmark<SampleType, ReverbTankSIMD<SampleType>>("ReverbTankSIMD/thick", reverbDensity::kThick));
+        benchmarks.push_back(makeTankBenchmark<SampleType, ReverbTankSIMD<SampleType>>("ReverbTankSIMD/sparse", reverbDensity::kSparse));
+    }
+
+    //==============================================================================
+    template <typename SampleType>
+    void runBenchmarks(const BenchmarkSettings& settings, BenchmarkReport& report)
+    {
+        std::vector<DSPBenchmark<SampleType>> benchmarks;
+        addFilterBenchmarks(benchmarks);
+        addStereoShelvingBenchmarks(benchmarks);
+        addDelayBufferBenchmarks(benchmarks);
+        addAPFBenchmarks(benchmarks);
+        addLFOBenchmarks(benchmarks);
+        addTankBenchmarks(benchmarks);
+
+        BlockTimer<SampleType> timer(settings);
+
+        for (auto& benchmark : benchmarks)
+        {
+            if (settings.filter.isNotEmpty() && !benchmark.name.containsIgnoreCase(settings.filter))
+                continue;
+
+            for (auto sampleRate : settings.sampleRates)
+            {
+                for (auto blockSize : settings.blockSizes)
+                {
+                    BenchmarkResult result;
+                    result.name = benchmark.name;
+                    result.sampleRate = sampleRate;
+                    result.numChannels = benchmark.numChannels;
+
+                    timer.measure(benchmark.prepare(sampleRate), blockSize, result);
+                    report.add(result);
+                }
+            }
+        }
+    }
+}
+
+//==============================================================================
+void runDSPBenchmarks(const BenchmarkSettings& settings, BenchmarkReport& report)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    if (settings.useDoublePrecision)
+        runBenchmarks<double>(settings, report);
+    else
+        runBenchmarks<float>(settings, report);
+}
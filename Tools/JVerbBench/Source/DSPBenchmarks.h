@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    DSPBenchmarks.h
+    Micro-benchmarks for each of the DSP objects on their own.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Benchmark.h"
+
+//==============================================================================
+/**
+    Times every DSP object at every sample rate and block size in settings: Biquad (each biquadAlgorithm),
+    AudioFilter (each filterAlgorithm), CircularBuffer/MirroredCircularBuffer reads, DelayAPF, NestedDelayAPF,
+    LFO and the whole ReverbTank (scalar and SIMD branches, thick and sparse). Each measurement gets a
+    freshly reset object.
+*/
+void runDSPBenchmarks(const BenchmarkSettings& settings, BenchmarkReport& report);
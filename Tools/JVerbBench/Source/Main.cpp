@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for JVerbBench: reproducible
+    timings of the JVerb DSP, written as JSON so they can be compared from
+    one build to the next.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "DSPBenchmarks.h"
+#include "ProcessorBenchmarks.h"
+
+//==============================================================================
+namespace
+{
+    /** take an option's value out of args; false if the option is not there */
+    bool removeOptionValue(juce::ArgumentList& args, juce::StringRef option, juce::String& value)
+    {
+        if (!args.containsOption(option))
+            return false;
+
+        value = args.removeValueForOption(option);
+        if (value.isEmpty())
+            juce::ConsoleApplication::fail(juce::String(option) + " needs a value");
+
+        return true;
+    }
+
+    /** a comma separated list of positive numbers */
+    template <typename ValueType>
+    juce::Array<ValueType> parseList(const juce::String& option, const juce::String& text)
+    {
+        juce::Array<ValueType> values;
+        for (auto& item : juce::StringArray::fromTokens(text, ",", ""))
+        {
+            auto value = (ValueType)item.trim().getDoubleValue();
+            if (value <= 0)
+                juce::ConsoleApplication::fail(option + " needs a list of positive numbers, not " + text.quoted());
+
+            values.add(value);
+        }
+
+        return values;
+    }
+
+    /** the options every mode shares; removes them from args */
+    BenchmarkSettings parseBenchmarkSettings(juce::ArgumentList& args)
+    {
+        BenchmarkSettings settings;
+        juce::String value;
+
+        if (removeOptionValue(args, "--rates", value))
+            settings.sampleRates = parseList<double>("--rates", value);
+
+        if (removeOptionValue(args, "--blocks", value))
+            settings.blockSizes = parseList<int>("--blocks", value);
+
+        if (removeOptionValue(args, "--samples", value))
+            settings.numSamples = juce::jmax(1, value.getIntValue());
+
+        if (removeOptionValue(args, "--repeats", value))
+            settings.numRepeats = juce::jmax(1, value.getIntValue());
+
+        if (removeOptionValue(args, "--filter", value))
+            settings.filter = value;
+
+        settings.useDoublePrecision = args.removeOptionIfFound("--double");
+        return settings;
+    }
+
+    /** the JSON file from --json, or the default name for the mode */
+    juce::File parseReportFile(juce::ArgumentList& args, const juce::String& mode)
+    {
+        juce::String value;
+        if (!removeOptionValue(args, "--json", value))
+            value = "JVerbBench-" + mode + ".json";
+
+        return juce::File::getCurrentWorkingDirectory().getChildFile(value);
+    }
+
+    void failOnUnusedArguments(const juce::ArgumentList& args)
+    {
+        for (auto& arg : args.arguments)
+            juce::ConsoleApplication::fail("unknown argument " + arg.text.quoted());
+    }
+
+    void writeReport(const BenchmarkReport& report, const juce::File& file)
+    {
+        auto result = report.writeJSON(file);
+        if (result.failed())
+            juce::ConsoleApplication::fail(result.getErrorMessage());
+
+        std::cout << "wrote " << file.getFullPathName() << std::endl;
+    }
+
+    //==============================================================================
+    void runDSPMode(const juce::ArgumentList& commandLine)
+    {
+        auto args = commandLine;
+        args.removeOptionIfFound("--dsp");
+
+        auto settings = parseBenchmarkSettings(args);
+        auto reportFile = parseReportFile(args, "dsp");
+        failOnUnusedArguments(args);
+
+        BenchmarkReport report("dsp", settings);
+        runDSPBenchmarks(settings, report);
+        writeReport(report, reportFile);
+    }
+
+    void runProcessorMode(const juce::ArgumentList& commandLine)
+    {
+        auto args = commandLine;
+        args.removeOptionIfFound("--processor");
+
+        auto settings = parseBenchmarkSettings(args);
+        auto reportFile = parseReportFile(args, "processor");
+        failOnUnusedArguments(args);
+
+        // --- the processor's apvts needs a message manager, as it has inside a host
+        juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+        BenchmarkReport report("processor", settings);
+        runProcessorBenchmarks(settings, report);
+        writeReport(report, reportFile);
+    }
+
+    void runInstancesMode(const juce::ArgumentList& commandLine)
+    {
+        auto args = commandLine;
+        args.removeOptionIfFound("--instances");
+
+        // --- a session is costly to time, so by default only at 48 kHz and two common host block sizes
+        auto useDefaultRates = !args.containsOption("--rates");
+        auto useDefaultBlocks = !args.containsOption("--blocks");
+
+        auto settings = parseBenchmarkSettings(args);
+        juce::String value;
+
+        if (useDefaultRates)
+            settings.sampleRates = { 48000.0 };
+
+        if (useDefaultBlocks)
+            settings.blockSizes = { 64, 256 };
+
+        if (removeOptionValue(args, "--counts", value))
+            settings.instanceCounts = parseList<int>("--counts", value);
+
+        if (removeOptionValue(args, "--threads", value))
+            settings.numThreads = juce::jmax(1, value.getIntValue());
+
+        auto reportFile = parseReportFile(args, "instances");
+        failOnUnusedArguments(args);
+
+        juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+        BenchmarkReport report("instances", settings);
+        runInstanceBenchmarks(settings, report);
+        writeReport(report, reportFile);
+    }
+
+    const char* const kCommonHelp =
+        "  --rates <list>       sample rates, e.g. 44100,48000 (default 44100,48000,96000,192000)\n"
+        "  --blocks <list>      block sizes (default 16,32,64,128,256,512,1024,2048,4096)\n"
+        "  --samples <n>        samples per timed run (default 65536)\n"
+        "  --repeats <n>        timed runs per measurement, the fastest is reported (default 5)\n"
+        "  --filter <text>      only run benchmarks whose name contains text\n"
+        "  --double             run the DSP in double precision\n"
+        "  --json <file>        where to write the results";
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand("--help|-h", "JVerb benchmarks", false);
+    app.addDefaultCommand({ "--dsp", "[options]", "Time each DSP object on its own (the default mode)",
+                            juce::String("Measures ns/sample and samples/second for Biquad, AudioFilter, CircularBuffer, DelayAPF, "
+                                         "NestedDelayAPF, LFO and ReverbTank at every sample rate and block size. Results go to "
+                                         "JVerbBench-dsp.json unless --json says otherwise.\n\n") + kCommonHelp,
+                            runDSPMode });
+    app.addCommand({ "--processor", "--processor [options]", "Time the whole plug-in's processBlock() under automation",
+                     juce::String("Drives JVerbAudioProcessor like a host: prepareToPlay(), then stereo noise one block at a time, "
+                                  "with the parameters left alone and with all of them automated before every block. Reports "
+                                  "the mean, 99th percentile and worst block time against the real-time deadline. Results go "
+                                  "to JVerbBench-processor.json unless --json says otherwise.\n\n") + kCommonHelp,
+                     runProcessorMode });
+    app.addCommand({ "--instances", "--instances [options]", "Time a session of plug-in instances on a pool of threads",
+                     juce::String("Creates a session of automated JVerbAudioProcessor instances and runs them host-style: every cycle "
+                                  "each instance processes one block, spread over a pool of threads. For each instance count it "
+                                  "reports the throughput (how many instances fit in real time), the cost per instance on one "
+                                  "thread against one instance on its own (how much the combined delay memory thrashes L2/L3), "
+                                  "the parallel speedup and the cycle times against the deadline. Runs at 48 kHz with 64 and 256 "
+                                  "sample blocks unless --rates or --blocks say otherwise. Results go to "
+                                  "JVerbBench-instances.json unless --json says otherwise.\n\n"
+                                  "  --counts <list>      instance counts (default 1,2,4,8,16,32,48,64)\n"
+                                  "  --threads <n>        render pool threads (default one per physical core)\n") + kCommonHelp,
+                     runInstancesMode });
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,485 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmarks.cpp
+
+  ==============================================================================
+*/
+
+#include "ProcessorBenchmarks.h"
+#include "../../../Source/PluginProcessor.h"
+#include <iostream>
+
+//==============================================================================
+namespace
+{
+    // --- every parameter sweeps its whole normalised range at its own rate (sweeps per second); the
+    //     rates share no common period, so the run keeps meeting new combinations of settings
+    const char* const kParameterIDs[] = { "dryLevel_dB", "lowShelfBoostCut_dB", "kRT", "highShelfBoostCut_dB", "wetLevel_dB" };
+    const double kSweepRates_Hz[] = { 0.31, 0.53, 0.17, 0.71, 0.43 };
+
+    // --- input noise: long enough that consecutive blocks differ, quiet enough not to clip the wet path
+    const int kNoiseLength = 1 << 15;
+    const double kNoiseLevel = 0.25;
+    const int kNumChannels = 2;
+
+    // --- instances of a session start at different places in the noise and the automation
+    const int kInstanceNoiseOffset = 997;
+    const double kInstanceAutomationOffset_Sec = 1.7;
+
+    //==============================================================================
+    /** sets the apvts parameters from the host side, as automation would arrive between blocks */
+    class ParameterAutomation
+    {
+    public:
+        ParameterAutomation(juce::AudioProcessorValueTreeState& apvts)
+        {
+            for (auto* parameterID : kParameterIDs)
+            {
+                auto* parameter = apvts.getParameter(parameterID);
+                jassert(parameter != nullptr);
+                parameters.add(parameter);
+            }
+        }
+
+        /** set every parameter for the block that starts at time_Sec */
+        void apply(double time_Sec)
+        {
+            for (int i = 0; i < parameters.size(); i++)
+            {
+                auto phase = juce::MathConstants<double>::twoPi * kSweepRates_Hz[i] * time_Sec;
+                parameters[i]->setValueNotifyingHost((float)(0.5 + 0.5 * std::sin(phase)));
+            }
+        }
+
+    private:
+        juce::Array<juce::RangedAudioParameter*> parameters;
+    };
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType> makeNoise(juce::uint32 seed)
+    {
+        juce::AudioBuffer<SampleType> noise(kNumChannels, kNoiseLength);
+        juce::Random random((juce::int64)seed);
+        for (int ch = 0; ch < kNumChannels; ch++)
+            for (int i = 0; i < kNoiseLength; i++)
+                noise.setSample(ch, i, (SampleType)(kNoiseLevel * (2.0 * random.nextDouble() - 1.0)));
+
+        return noise;
+    }
+
+    //==============================================================================
+    /** One plug-in instance as a host runs it: the processor, its input/output buffer and its automation */
+    template <typename SampleType>
+    class ProcessorInstance
+    {
+    public:
+        /** prepared the way a host does it: precision first, then the play configuration */
+        ProcessorInstance(double _sampleRate, int _blockSize, int instanceIndex)
+            : sampleRate(_sampleRate), blockSize(_blockSize), buffer(kNumChannels, _blockSize), automation(processor.apvts)
+        {
+            jassert(blockSize <= kNoiseLength);
+
+            processor.setProcessingPrecision(std::is_same<SampleType, double>::value ? juce::AudioProcessor::doublePrecision
+                                                                                     : juce::AudioProcessor::singlePrecision);
+            processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+
+            position = (instanceIndex * kInstanceNoiseOffset) % (kNoiseLength - blockSize + 1);
+            time_Sec = instanceIndex * kInstanceAutomationOffset_Sec;
+        }
+
+        ~ProcessorInstance()
+        {
+            processor.releaseResources();
+        }
+
+        /** the host's side of a block: fill in the input and apply the automation */
+        void prepareBlock(const juce::AudioBuffer<SampleType>& noise, bool automate)
+        {
+            if (position + blockSize > kNoiseLength)
+                position = 0;
+
+            for (int ch = 0; ch < kNumChannels; ch++)
+                buffer.copyFrom(ch, 0, noise, ch, position, blockSize);
+
+            if (automate)
+                automation.apply(time_Sec);
+
+            position += blockSize;
+            time_Sec += blockSize / sampleRate;
+        }
+
+        /** the plug-in's side of a block */
+        void processBlock()
+        {
+            processor.processBlock(buffer, midi);
+            consumeBenchmarkOutput((double)buffer.getSample(0, blockSize - 1));
+        }
+
+    private:
+        const double sampleRate;
+        const int blockSize;
+
+        JVerbAudioProcessor processor;
+        juce::AudioBuffer<SampleType> buffer;
+        juce::MidiBuffer midi;
+        ParameterAutomation automation;
+
+        int position = 0;
+        double time_Sec = 0.0;
+
+        JUCE_DECLARE_NON_COPYABLE(ProcessorInstance)
+    };
+
+    /** the delay memory one instance cycles through at this sample rate, plus the tank itself */
+    template <typename SampleType>
+    size_t getTankWorkingSet_Bytes(double sampleRate)
+    {
+        auto tank = std::make_unique<ReverbTankSIMD<SampleType>>();
+        tank->reset(sampleRate);
+        return tank->getDelayArena().getCarvedLength() * sizeof(SampleType) + sizeof(ReverbTankSIMD<SampleType>);
+    }
+
+    //==============================================================================
+    /** Adds the distribution of block (or host cycle) times against the real-time deadline to result:
+        the mean, 99th percentile and worst time, each also as a fraction of the deadline, and the number
+        of blocks that missed it. Sorts times_Sec. */
+    void addBlockTimeStatistics(juce::Array<double>& times_Sec, double deadline_Sec, BenchmarkResult& result)
+    {
+        times_Sec.sort();
+
+        double totalTime_Sec = 0.0;
+        int numOverruns = 0;
+        for (auto time_Sec : times_Sec)
+        {
+            totalTime_Sec += time_Sec;
+            if (time_Sec > deadline_Sec)
+                numOverruns++;
+        }
+
+        auto numTimes = times_Sec.size();
+        auto mean_Sec = totalTime_Sec / numTimes;
+        auto p99_Sec = times_Sec[juce::jlimit(0, numTimes - 1, (int)std::ceil(0.99 * numTimes) - 1)];
+        auto worst_Sec = times_Sec.getLast();
+
+        result.extra.set("numBlocks", numTimes);
+        result.extra.set("deadline_uSec", deadline_Sec * 1.0e6);
+        result.extra.set("meanBlock_uSec", mean_Sec * 1.0e6);
+        result.extra.set("p99Block_uSec", p99_Sec * 1.0e6);
+        result.extra.set("worstBlock_uSec", worst_Sec * 1.0e6);
+        result.extra.set("meanLoad", mean_Sec / deadline_Sec);
+        result.extra.set("p99Load", p99_Sec / deadline_Sec);
+        result.extra.set("worstLoad", worst_Sec / deadline_Sec);
+        result.extra.set("numOverruns", numOverruns);
+    }
+
+    /** the second table line: the block times against the deadline */
+    void printBlockTimes(const BenchmarkResult& result)
+    {
+        auto get = [&result](const char* name) { return (double)result.extra[name]; };
+
+        std::cout << juce::String::formatted("    block time: mean %.2f us  p99 %.2f us  worst %.2f us  of %.2f us"
+                                             "  (p99 %.1f%%, worst %.1f%% of the deadline, %d overruns)",
+            get("meanBlock_uSec"), get("p99Block_uSec"), get("worstBlock_uSec"), get("deadline_uSec"),
+            get("p99Load") * 100.0, get("worstLoad") * 100.0, (int)result.extra["numOverruns"]) << std::endl;
+    }
+
+    //==============================================================================
+    /** times one processor at one sample rate and block size */
+    template <typename SampleType>
+    void measureProcessor(const BenchmarkSettings& settings, bool automate, int blockSize, BenchmarkResult& result)
+    {
+        const int numBlocks = juce::jmax(1, settings.numSamples / blockSize);
+        const int samplesPerRun = numBlocks * blockSize;
+
+        ProcessorInstance<SampleType> instance(result.sampleRate, blockSize, 0);
+        auto noise = makeNoise<SampleType>(settings.seed);
+
+        juce::Array<double> blockTimes_Sec, runTimes_Sec;
+        blockTimes_Sec.ensureStorageAllocated(numBlocks * juce::jmax(1, settings.numRepeats));
+
+        // --- one pass over numBlocks blocks; only processBlock( ) itself is inside the timer
+        auto runOnce = [&](bool keepTimes)
+        {
+            double runTime_Sec = 0.0;
+            for (int block = 0; block < numBlocks; block++)
+            {
+                instance.prepareBlock(noise, automate);
+
+                auto start = juce::Time::getHighResolutionTicks();
+                instance.processBlock();
+                auto blockTime_Sec = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+                runTime_Sec += blockTime_Sec;
+                if (keepTimes)
+                    blockTimes_Sec.add(blockTime_Sec);
+            }
+
+            return runTime_Sec;
+        };
+
+        // --- warm up the caches and branch predictors, then time
+        runOnce(false);
+        for (int repeat = 0; repeat < juce::jmax(1, settings.numRepeats); repeat++)
+            runTimes_Sec.add(runOnce(true));
+
+        runTimes_Sec.sort();
+        result.blockSize = blockSize;
+        result.numChannels = kNumChannels;
+        result.nsPerSample = runTimes_Sec.getFirst() * 1.0e9 / samplesPerRun;
+        result.nsPerSampleMedian = runTimes_Sec[runTimes_Sec.size() / 2] * 1.0e9 / samplesPerRun;
+        result.samplesPerSecond = samplesPerRun / juce::jmax(runTimes_Sec.getFirst(), 1.0e-12);
+
+        // --- the block time distribution over every timed block of every run
+        result.extra.set("automated", automate);
+        addBlockTimeStatistics(blockTimes_Sec, blockSize / result.sampleRate, result);
+    }
+
+    template <typename SampleType>
+    void runSingleInstance(const BenchmarkSettings& settings, BenchmarkReport& report)
+    {
+        for (auto automate : { false, true })
+        {
+            juce::String name = automate ? "JVerbAudioProcessor/automated" : "JVerbAudioProcessor/static";
+            if (settings.filter.isNotEmpty() && !name.containsIgnoreCase(settings.filter))
+                continue;
+
+            for (auto sampleRate : settings.sampleRates)
+            {
+                for (auto blockSize : settings.blockSizes)
+                {
+                    BenchmarkResult result;
+                    result.name = name;
+                    result.sampleRate = sampleRate;
+
+                    measureProcessor<SampleType>(settings, automate, blockSize, result);
+                    report.add(result);
+                    printBlockTimes(result);
+                }
+            }
+        }
+    }
+
+    //==============================================================================
+    /**
+        A host-style render pool: every host cycle, numThreads threads (the calling thread included) take
+        instances from a shared counter until all of them have processed their block; the cycle is over when
+        the last one is done. The workers sleep between cycles, like the audio workgroups of most hosts.
+    */
+    class RenderPool
+    {
+    public:
+        using ProcessFunction = std::function<void(int instanceIndex)>;
+
+        RenderPool(int numThreads, ProcessFunction _process)
+            : process(std::move(_process))
+        {
+            for (int i = 1; i < numThreads; i++)
+                workers.add(new Worker(*this, i));
+
+            for (auto* worker : workers)
+                worker->startThread();
+        }
+
+        ~RenderPool()
+        {
+            for (auto* worker : workers)
+            {
+                worker->signalThreadShouldExit();
+                worker->start.signal();
+            }
+
+            for (auto* worker : workers)
+                worker->stopThread(-1);
+        }
+
+        /** process numInstances instances once; returns when all of them are done */
+        void runCycle(int numInstances)
+        {
+            numCycleInstances = numInstances;
+            nextInstance = 0;
+            numBusyWorkers = workers.size();
+
+            for (auto* worker : workers)
+                worker->start.signal();
+
+            processInstances();
+
+            if (!workers.isEmpty())
+                finished.wait(-1);
+        }
+
+    private:
+        void processInstances()
+        {
+            for (int i = nextInstance++; i < numCycleInstances; i = nextInstance++)
+                process(i);
+        }
+
+        struct Worker : public juce::Thread
+        {
+            Worker(RenderPool& _pool, int index)
+                : juce::Thread("JVerbBench worker " + juce::String(index)), pool(_pool) {}
+
+            void run() override
+            {
+                for (;;)
+                {
+                    start.wait(-1);
+                    if (threadShouldExit())
+                        return;
+
+                    pool.processInstances();
+                    if (--pool.numBusyWorkers == 0)
+                        pool.finished.signal();
+                }
+            }
+
+            RenderPool& pool;
+            juce::WaitableEvent start;
+        };
+
+        ProcessFunction process;
+        juce::OwnedArray<Worker> workers;
+        juce::WaitableEvent finished;
+
+        std::atomic<int> numCycleInstances { 0 };
+        std::atomic<int> nextInstance { 0 };
+        std::atomic<int> numBusyWorkers { 0 };
+    };
+
+    /** the host cycle times of numInstances instances on a pool of numThreads; returns the time of each run */
+    template <typename SampleType>
+    juce::Array<double> timeHostCycles(const BenchmarkSettings& settings, std::vector<std::unique_ptr<ProcessorInstance<SampleType>>>& instances,
+                                       const juce::AudioBuffer<SampleType>& noise, int numInstances, int numThreads,
+                                       int numCycles, juce::Array<double>* cycleTimes_Sec)
+    {
+        // --- the host's part of the cycle (input and automation) runs in the cycle too, on the same thread
+        RenderPool pool(numThreads, [&](int i)
+        {
+            instances[(size_t)i]->prepareBlock(noise, true);
+            instances[(size_t)i]->processBlock();
+        });
+
+        auto runOnce = [&](bool keepTimes)
+        {
+            double runTime_Sec = 0.0;
+            for (int cycle = 0; cycle < numCycles; cycle++)
+            {
+                auto start = juce::Time::getHighResolutionTicks();
+                pool.runCycle(numInstances);
+                auto cycleTime_Sec = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+                runTime_Sec += cycleTime_Sec;
+                if (keepTimes && cycleTimes_Sec != nullptr)
+                    cycleTimes_Sec->add(cycleTime_Sec);
+            }
+
+            return runTime_Sec;
+        };
+
+        // --- warm up the caches and branch predictors, then time
+        juce::Array<double> runTimes_Sec;
+        runOnce(false);
+        for (int repeat = 0; repeat < juce::jmax(1, settings.numRepeats); repeat++)
+            runTimes_Sec.add(runOnce(true));
+
+        runTimes_Sec.sort();
+        return runTimes_Sec;
+    }
+
+    template <typename SampleType>
+    void runSession(const BenchmarkSettings& settings, BenchmarkReport& report)
+    {
+        const juce::String name = "JVerbAudioProcessor/instances";
+        if (settings.filter.isNotEmpty() && !name.containsIgnoreCase(settings.filter))
+            return;
+
+        const int numThreads = settings.numThreads > 0 ? settings.numThreads : juce::SystemStats::getNumPhysicalCpus();
+        auto noise = makeNoise<SampleType>(settings.seed);
+
+        int maxInstances = 1;
+        for (auto numInstances : settings.instanceCounts)
+            maxInstances = juce::jmax(maxInstances, numInstances);
+
+        for (auto sampleRate : settings.sampleRates)
+        {
+            const auto workingSet_Bytes = getTankWorkingSet_Bytes<SampleType>(sampleRate);
+
+            for (auto blockSize : settings.blockSizes)
+            {
+                const int numCycles = juce::jmax(1, settings.numSamples / blockSize);
+                const double deadline_Sec = blockSize / sampleRate;
+
+                // --- the session: every instance is created and prepared up front, as a host loading a project
+                std::vector<std::unique_ptr<ProcessorInstance<SampleType>>> instances;
+                for (int i = 0; i < maxInstances; i++)
+                    instances.push_back(std::make_unique<ProcessorInstance<SampleType>>(sampleRate, blockSize, i));
+
+                // --- one instance on one thread, over and over: everything it touches stays in the caches
+                auto hotRunTimes_Sec = timeHostCycles(settings, instances, noise, 1, 1, numCycles, nullptr);
+                const double hotNsPerSample = hotRunTimes_Sec.getFirst() * 1.0e9 / (numCycles * blockSize);
+
+                for (auto numInstances : settings.instanceCounts)
+                {
+                    const double samplesPerRun = (double)numCycles * blockSize * numInstances;
+
+                    // --- all instances in turn on one thread: the cost per instance grows as their combined
+                    //     delay memory spills out of L2, then L3
+                    auto serialRunTimes_Sec = timeHostCycles(settings, instances, noise, numInstances, 1, numCycles, nullptr);
+                    const double serialNsPerSample = serialRunTimes_Sec.getFirst() * 1.0e9 / samplesPerRun;
+
+                    // --- then as the host would: spread over the pool
+                    const int poolThreads = juce::jmin(numThreads, numInstances);
+                    juce::Array<double> cycleTimes_Sec;
+                    auto poolRunTimes_Sec = timeHostCycles(settings, instances, noise, numInstances, poolThreads, numCycles, &cycleTimes_Sec);
+
+                    BenchmarkResult result;
+                    result.name = name;
+                    result.sampleRate = sampleRate;
+                    result.blockSize = blockSize;
+                    result.numChannels = kNumChannels;
+                    result.nsPerSample = poolRunTimes_Sec.getFirst() * 1.0e9 / samplesPerRun;
+                    result.nsPerSampleMedian = poolRunTimes_Sec[poolRunTimes_Sec.size() / 2] * 1.0e9 / samplesPerRun;
+                    result.samplesPerSecond = samplesPerRun / juce::jmax(poolRunTimes_Sec.getFirst(), 1.0e-12);
+
+                    result.extra.set("numInstances", numInstances);
+                    result.extra.set("numThreads", poolThreads);
+                    result.extra.set("workingSetPerInstance_kB", (double)workingSet_Bytes / 1024.0);
+                    result.extra.set("workingSet_kB", (double)workingSet_Bytes * numInstances / 1024.0);
+                    result.extra.set("hotNsPerSample", hotNsPerSample);
+                    result.extra.set("serialNsPerSample", serialNsPerSample);
+                    result.extra.set("cacheSensitivity", serialNsPerSample / hotNsPerSample);
+                    result.extra.set("parallelSpeedup", serialNsPerSample / result.nsPerSample);
+                    addBlockTimeStatistics(cycleTimes_Sec, deadline_Sec, result);
+
+                    report.add(result);
+                    std::cout << juce::String::formatted("    %d instances on %d threads: %.0f kB of delay memory, %.2f ns/sample each on one thread"
+                                                         " (%.2fx one hot instance), %.2fx parallel speedup",
+                        numInstances, poolThreads, (double)workingSet_Bytes * numInstances / 1024.0, serialNsPerSample,
+                        serialNsPerSample / hotNsPerSample, serialNsPerSample / result.nsPerSample) << std::endl;
+                    printBlockTimes(result);
+                }
+            }
+        }
+    }
+}
+
+//==============================================================================
+void runProcessorBenchmarks(const BenchmarkSettings& settings, BenchmarkReport& report)
+{
+    // --- processBlock( ) sets its own ScopedNoDenormals, as it does in a host
+    if (settings.useDoublePrecision)
+        runSingleInstance<double>(settings, report);
+    else
+        runSingleInstance<float>(settings, report);
+}
+
+void runInstanceBenchmarks(const BenchmarkSettings& settings, BenchmarkReport& report)
+{
+    if (settings.useDoublePrecision)
+        runSession<double>(settings, report);
+    else
+        runSession<float>(settings, report);
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmarks.h
+    End-to-end timing of JVerbAudioProcessor::processBlock( ), the way a host drives it:
+    one instance at a time, or a whole session of them on a pool of threads.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Benchmark.h"
+
+//==============================================================================
+/**
+    Times the whole plug-in at every sample rate and block size in settings: a JVerbAudioProcessor is
+    prepared like a host would (precision, rate, block size, prepareToPlay( )) and fed stereo noise one
+    block at a time. Two variants are run:
+
+    "JVerbAudioProcessor/static"    - the parameters stay at their defaults
+    "JVerbAudioProcessor/automated" - all five apvts parameters sweep their ranges at unrelated rates
+                                      and are set before every block, the way host automation arrives,
+                                      so the smoothers and coefficient updates never rest
+
+    Every block is timed on its own; besides ns/sample the results carry the mean, 99th percentile and
+    worst block time against the real-time deadline (blockSize / sampleRate).
+
+    Needs a MessageManager (the apvts starts a timer): call it with a ScopedJuceInitialiser_GUI alive.
+*/
+void runProcessorBenchmarks(const BenchmarkSettings& settings, BenchmarkReport& report);
+
+/**
+    Times a session of JVerbAudioProcessor instances at every sample rate and block size in settings, for
+    each of settings.instanceCounts. All instances are automated and start at different points of the input
+    and automation. Every host cycle hands each instance one block; settings.numThreads threads (the calling
+    thread among them) take the instances from a shared counter, and the cycle ends when all are done.
+
+    Each result ("JVerbAudioProcessor/instances") reports, besides the cycle time distribution against the
+    deadline:
+
+    - samplesPerSecond: instance-samples per second over the pool; realTimeFactor is then the number of
+      instances that fit in real time
+    - nsPerSample: the pool's wall time per instance-sample
+    - serialNsPerSample: the cost per instance-sample with all instances in turn on one thread
+    - cacheSensitivity: serialNsPerSample over the cost of one instance run on its own (everything it touches
+      hot in the caches); it grows as the delay memory of the session (workingSet_kB) outgrows L2 and L3
+    - parallelSpeedup: serialNsPerSample over nsPerSample
+
+    Needs a MessageManager, like runProcessorBenchmarks( ).
+*/
+void runInstanceBenchmarks(const BenchmarkSettings& settings, BenchmarkReport& report);
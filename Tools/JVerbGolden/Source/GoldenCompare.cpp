@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    GoldenCompare.cpp
+
+  ==============================================================================
+*/
+
+#include "GoldenCompare.h"
+#include <complex>
+
+//==============================================================================
+namespace
+{
+    using Complex = std::complex<double>;
+
+    /** in-place radix-2 FFT; data.size( ) must be a power of two */
+    void fft(std::vector<Complex>& data)
+    {
+        const size_t n = data.size();
+
+        for (size_t i = 1, j = 0; i < n; i++)
+        {
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+
+            if (i < j)
+                std::swap(data[i], data[j]);
+        }
+
+        for (size_t length = 2; length <= n; length <<= 1)
+        {
+            auto step = std::polar(1.0, -juce::MathConstants<double>::twoPi / (double)length);
+            for (size_t start = 0; start < n; start += length)
+            {
+                Complex w(1.0, 0.0);
+                for (size_t k = 0; k < length / 2; k++)
+                {
+                    auto even = data[start + k];
+                    auto odd = data[start + k + length / 2] * w;
+                    data[start + k] = even + odd;
+                    data[start + k + length / 2] = even - odd;
+                    w *= step;
+                }
+            }
+        }
+    }
+
+    /** the magnitude spectra of the Hann-windowed, half-overlapping frames of one channel, frame after frame */
+    std::vector<double> getSpectrogram(const double* samples, int numSamples)
+    {
+        const int numBins = kSpectralFrameSize / 2 + 1;
+        const int hop = kSpectralFrameSize / 2;
+
+        std::vector<double> window((size_t)kSpectralFrameSize);
+        for (int i = 0; i < kSpectralFrameSize; i++)
+            window[(size_t)i] = 0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / kSpectralFrameSize);
+
+        std::vector<double> magnitudes;
+        std::vector<Complex> frame((size_t)kSpectralFrameSize);
+
+        for (int start = 0; start < numSamples; start += hop)
+        {
+            for (int i = 0; i < kSpectralFrameSize; i++)
+                frame[(size_t)i] = start + i < numSamples ? samples[start + i] * window[(size_t)i] : 0.0;
+
+            fft(frame);
+            for (int bin = 0; bin < numBins; bin++)
+                magnitudes.push_back(std::abs(frame[(size_t)bin]));
+        }
+
+        return magnitudes;
+    }
+}
+
+//==============================================================================
+GoldenTolerance GoldenTolerance::forPrecision(bool isDoublePrecision)
+{
+    // --- double: only the rounding of reordered arithmetic; float: the float tanks stay within about
+    //     5e-6 of the double reference on the long tails, so allow -80 dBFS
+    if (isDoublePrecision)
+        return { 1.0e-9, 0.001 };
+
+    return { 1.0e-4, 0.1 };
+}
+
+bool GoldenComparison::passes(const GoldenTolerance& tolerance) const
+{
+    return lengthsMatch
+        && maxError <= tolerance.maxError
+        && spectralMaxDiff_dB <= tolerance.spectralDiff_dB;
+}
+
+//==============================================================================
+GoldenComparison compareToGolden(const juce::AudioBuffer<double>& reference, const juce::AudioBuffer<double>& test)
+{
+    GoldenComparison comparison;
+    comparison.lengthsMatch = reference.getNumChannels() == test.getNumChannels()
+                           && reference.getNumSamples() == test.getNumSamples();
+
+    const int numChannels = juce::jmin(reference.getNumChannels(), test.getNumChannels());
+    const int numSamples = juce::jmin(reference.getNumSamples(), test.getNumSamples());
+
+    // --- sample by sample
+    double errorEnergy = 0.0, referenceEnergy = 0.0;
+    for (int ch = 0; ch < numChannels; ch++)
+    {
+        auto* ref = reference.getReadPointer(ch);
+        auto* out = test.getReadPointer(ch);
+
+        for (int i = 0; i < numSamples; i++)
+        {
+            auto error = out[i] - ref[i];
+            comparison.maxError = juce::jmax(comparison.maxError, std::abs(error));
+            errorEnergy += error * error;
+            referenceEnergy += ref[i] * ref[i];
+        }
+    }
+
+    if (errorEnergy > 0.0 && referenceEnergy > 0.0)
+        comparison.rmsError_dB = juce::jmax(kGoldenExactMatch_dB, 10.0 * std::log10(errorEnergy / referenceEnergy));
+    else
+        comparison.rmsError_dB = errorEnergy > 0.0 ? 0.0 : kGoldenExactMatch_dB;
+
+    // --- short-time spectra; the audible range is set by the loudest reference bin of any channel
+    std::vector<std::vector<double>> referenceSpectra, testSpectra;
+    double peakMagnitude = 0.0;
+
+    for (int ch = 0; ch < numChannels; ch++)
+    {
+        referenceSpectra.push_back(getSpectrogram(reference.getReadPointer(ch), numSamples));
+        testSpectra.push_back(getSpectrogram(test.getReadPointer(ch), numSamples));
+
+        for (auto magnitude : referenceSpectra.back())
+            peakMagnitude = juce::jmax(peakMagnitude, magnitude);
+    }
+
+    const double threshold = peakMagnitude * juce::Decibels::decibelsToGain(-kSpectralRange_dB, -1000.0);
+    const double floor = threshold * 1.0e-3;
+    double totalDiff_dB = 0.0;
+    juce::int64 numBins = 0;
+
+    for (size_t ch = 0; ch < referenceSpectra.size(); ch++)
+    {
+        for (size_t bin = 0; bin < referenceSpectra[ch].size(); bin++)
+        {
+            auto ref = referenceSpectra[ch][bin];
+            if (ref <= threshold || ref <= 0.0)
+                continue;
+
+            auto diff_dB = std::abs(20.0 * std::log10(juce::jmax(testSpectra[ch][bin], floor) / ref));
+            comparison.spectralMaxDiff_dB = juce::jmax(comparison.spectralMaxDiff_dB, diff_dB);
+            totalDiff_dB += diff_dB;
+            numBins++;
+        }
+    }
+
+    comparison.spectralMeanDiff_dB = numBins > 0 ? totalDiff_dB / (double)numBins : 0.0;
+    return comparison;
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    GoldenCompare.h
+    Error and spectral-difference metrics between a render and its reference.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// --- the spectral metric's frame size (a power of two) and dynamic range
+const int kSpectralFrameSize = 2048;
+const double kSpectralRange_dB = 100.0;
+
+// --- what an exact match reports as rmsError_dB
+const double kGoldenExactMatch_dB = -400.0;
+
+//==============================================================================
+/** How far a variant may stray from the reference and still pass */
+struct GoldenTolerance
+{
+    double maxError = 0.0;              // largest absolute sample difference
+    double spectralDiff_dB = 0.0;       // largest magnitude difference of any audible spectrogram bin
+
+    /** the defaults: double variants must match to rounding noise, float variants to float precision */
+    static GoldenTolerance forPrecision(bool isDoublePrecision);
+};
+
+//==============================================================================
+/** The differences between a render and its reference, over all channels */
+struct GoldenComparison
+{
+    double maxError = 0.0;              // largest absolute sample difference
+    double rmsError_dB = 0.0;           // RMS of the difference relative to the RMS of the reference
+    double spectralMaxDiff_dB = 0.0;    // largest |test - reference| magnitude in dB over the audible bins
+    double spectralMeanDiff_dB = 0.0;   // mean of the same (the log-spectral distance)
+    bool lengthsMatch = true;
+
+    bool passes(const GoldenTolerance& tolerance) const;
+};
+
+/**
+    Compares test against reference sample by sample and as short-time spectra: both are cut into
+    Hann-windowed frames of kSpectralFrameSize samples (half overlapping) and the magnitude of every bin
+    within kSpectralRange_dB of the loudest bin of the reference is compared in dB. The range keeps the
+    metric on what can be heard instead of on the numerical noise floor of the tail.
+*/
+GoldenComparison compareToGolden(const juce::AudioBuffer<double>& reference, const juce::AudioBuffer<double>& test);
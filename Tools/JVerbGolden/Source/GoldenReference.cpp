@@ -0,0 +1,257 @@
+/*
+  ==============================================================================
+
+    GoldenReference.cpp
+
+  ==============================================================================
+*/
+
+#include "GoldenReference.h"
+
+//==============================================================================
+namespace
+{
+    const int kGoldenFileTag = 0x5247564a;  // "JVGR"
+    const int kGoldenFileVersion = 1;
+
+    const char* const kStimulusNames[] = { "impulse", "noise", "sweep" };
+    const char* const kPresetNames[] = { "default", "sparse", "long" };
+
+    const double kStimulusLevel = 0.5;      // -6 dBFS
+
+    /** xorshift32: the noise must not depend on juce::Random or the standard library staying the same */
+    class GoldenNoise
+    {
+    public:
+        explicit GoldenNoise(juce::uint32 seed) : state(seed) {}
+
+        /** uniform in [-1, 1) */
+        double next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state / 2147483648.0 - 1.0;
+        }
+
+    private:
+        juce::uint32 state;
+    };
+
+    int toSamples(double time_Sec, double sampleRate)
+    {
+        return juce::roundToInt(time_Sec * sampleRate);
+    }
+
+    //==============================================================================
+    /** run a buffer through a freshly reset tank of any sample type, the way the plugin does */
+    template <typename TankType, typename SampleType>
+    void renderTank(juce::AudioBuffer<double>& buffer, const ReverbTankParameters& params, double sampleRate, int blockSize)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        // --- flush after the parameters so the render starts at them instead of ramping from the defaults
+        //     over the first block, which would make the output depend on the block size
+        auto tank = std::make_unique<TankType>();
+        tank->reset(sampleRate);
+        tank->setParameters(params);
+        tank->flush();
+
+        juce::AudioBuffer<SampleType> samples;
+        samples.makeCopyOf(buffer);
+
+        const int numChannels = juce::jmin(samples.getNumChannels(), (int)NUM_CHANNELS);
+        SampleType* channelData[NUM_CHANNELS] = { nullptr };
+
+        for (int offset = 0; offset < samples.getNumSamples(); offset += blockSize)
+        {
+            auto numSamples = juce::jmin(blockSize, samples.getNumSamples() - offset);
+            for (int ch = 0; ch < numChannels; ch++)
+                channelData[ch] = samples.getWritePointer(ch, offset);
+
+            tank->processBlock(channelData, channelData, numChannels, numSamples);
+        }
+
+        buffer.makeCopyOf(samples);
+    }
+}
+
+//==============================================================================
+juce::String GoldenCase::getName() const
+{
+    return stimulus + "_" + preset + "_" + juce::String(juce::roundToInt(sampleRate));
+}
+
+juce::File GoldenCase::getReferenceFile(const juce::File& directory) const
+{
+    return directory.getChildFile(getName() + ".jvgr");
+}
+
+juce::Array<GoldenCase> getGoldenCases(const juce::Array<double>& sampleRates)
+{
+    juce::Array<GoldenCase> cases;
+    for (auto sampleRate : sampleRates)
+        for (auto* stimulus : kStimulusNames)
+            for (auto* preset : kPresetNames)
+                cases.add({ stimulus, preset, sampleRate });
+
+    return cases;
+}
+
+//==============================================================================
+juce::AudioBuffer<double> makeGoldenStimulus(const GoldenCase& goldenCase)
+{
+    const auto sampleRate = goldenCase.sampleRate;
+    juce::AudioBuffer<double> buffer;
+
+    if (goldenCase.stimulus == "impulse")
+    {
+        buffer.setSize(2, toSamples(3.0, sampleRate));
+        buffer.clear();
+        buffer.setSample(0, 0, 1.0);
+        buffer.setSample(1, toSamples(0.01, sampleRate), 1.0);
+    }
+    else if (goldenCase.stimulus == "noise")
+    {
+        buffer.setSize(2, toSamples(3.0, sampleRate));
+        buffer.clear();
+
+        auto length = toSamples(1.0, sampleRate);
+        for (int ch = 0; ch < 2; ch++)
+        {
+            GoldenNoise noise(0x4a566572u + (juce::uint32)ch);
+            for (int i = 0; i < length; i++)
+                buffer.setSample(ch, i, kStimulusLevel * noise.next());
+        }
+    }
+    else if (goldenCase.stimulus == "sweep")
+    {
+        buffer.setSize(2, toSamples(3.5, sampleRate));
+        buffer.clear();
+
+        // --- exponential sweep: the instantaneous frequency rises from f1 to f2 at a constant rate in octaves
+        const double f1 = 20.0;
+        const double f2 = juce::jmin(20000.0, 0.45 * sampleRate);
+        const double duration_Sec = 2.0;
+        const double rate = std::log(f2 / f1);
+        const double k = juce::MathConstants<double>::twoPi * f1 * duration_Sec / rate;
+
+        auto length = toSamples(duration_Sec, sampleRate);
+        for (int i = 0; i < length; i++)
+        {
+            auto t = i / sampleRate;
+            auto value = kStimulusLevel * std::sin(k * (std::exp(t * rate / duration_Sec) - 1.0));
+            buffer.setSample(0, i, value);
+            buffer.setSample(1, i, value);
+        }
+    }
+    else
+    {
+        jassertfalse;
+    }
+
+    return buffer;
+}
+
+ReverbTankParameters getGoldenPreset(const juce::String& preset)
+{
+    ReverbTankParameters params;
+
+    if (preset == "sparse")
+    {
+        params.density = reverbDensity::kSparse;
+        params.kRT = 0.7;
+        params.lpf_g = 0.5;
+        params.preDelayTime_mSec = 40.0;
+        params.lowShelfBoostCut_dB = 6.0;
+        params.highShelfBoostCut_dB = 3.0;
+        params.wetLevel_dB = -6.0;
+    }
+    else if (preset == "long")
+    {
+        params.kRT = 0.99;
+        params.lpf_g = 0.1;
+        params.preDelayTime_mSec = 5.0;
+        params.lowShelfBoostCut_dB = 0.0;
+        params.highShelfBoostCut_dB = 0.0;
+        params.wetLevel_dB = 0.0;
+        params.dryLevel_dB = -60.0;
+    }
+    else
+    {
+        jassert(preset == "default");
+    }
+
+    return params;
+}
+
+//==============================================================================
+std::vector<TankVariant> getTankVariants()
+{
+    return {
+        { "ReverbTank<double>",     true,  renderTank<ReverbTank<double>, double> },
+        { "ReverbTank<float>",      false, renderTank<ReverbTank<float>, float> },
+        { "ReverbTankSIMD<double>", true,  renderTank<ReverbTankSIMD<double>, double> },
+        { "ReverbTankSIMD<float>",  false, renderTank<ReverbTankSIMD<float>, float> },
+    };
+}
+
+juce::AudioBuffer<double> renderGoldenReference(const GoldenCase& goldenCase)
+{
+    auto buffer = makeGoldenStimulus(goldenCase);
+    renderTank<ReverbTank<double>, double>(buffer, getGoldenPreset(goldenCase.preset), goldenCase.sampleRate,
+                                           kGoldenReferenceBlockSize);
+    return buffer;
+}
+
+//==============================================================================
+juce::Result writeGoldenFile(const juce::File& file, const juce::AudioBuffer<double>& output, double sampleRate)
+{
+    file.deleteFile();
+
+    juce::FileOutputStream stream(file);
+    if (stream.failedToOpen())
+        return juce::Result::fail("cannot write " + file.getFullPathName());
+
+    stream.writeInt(kGoldenFileTag);
+    stream.writeInt(kGoldenFileVersion);
+    stream.writeDouble(sampleRate);
+    stream.writeInt(output.getNumChannels());
+    stream.writeInt(output.getNumSamples());
+
+    for (int ch = 0; ch < output.getNumChannels(); ch++)
+        for (int i = 0; i < output.getNumSamples(); i++)
+            stream.writeDouble(output.getSample(ch, i));
+
+    stream.flush();
+    if (stream.getStatus().failed())
+        return juce::Result::fail("cannot write " + file.getFullPathName() + ": " + stream.getStatus().getErrorMessage());
+
+    return juce::Result::ok();
+}
+
+juce::Result readGoldenFile(const juce::File& file, juce::AudioBuffer<double>& output, double& sampleRate)
+{
+    juce::FileInputStream stream(file);
+    if (stream.failedToOpen())
+        return juce::Result::fail("cannot read " + file.getFullPathName());
+
+    if (stream.readInt() != kGoldenFileTag || stream.readInt() != kGoldenFileVersion)
+        return juce::Result::fail(file.getFullPathName() + " is not a version " + juce::String(kGoldenFileVersion)
+                                  + " golden reference");
+
+    sampleRate = stream.readDouble();
+    auto numChannels = stream.readInt();
+    auto numSamples = stream.readInt();
+
+    auto expectedSize = (juce::int64)numChannels * numSamples * (juce::int64)sizeof(double);
+    if (numChannels <= 0 || numSamples <= 0 || stream.getNumBytesRemaining() != expectedSize)
+        return juce::Result::fail(file.getFullPathName() + " is truncated or damaged");
+
+    output.setSize(numChannels, numSamples);
+    for (int ch = 0; ch < numChannels; ch++)
+        for (int i = 0; i < numSamples; i++)
+            output.setSample(ch, i, stream.readDouble());
+
+    return juce::Result::ok();
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    GoldenReference.h
+    The fixed stimuli and tank presets of the golden-output references, the
+    tank variants checked against them, and the reference file format.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/DSP/ReverbTank.h"
+
+//==============================================================================
+// --- the references are rendered by the scalar double tank in blocks of this size
+const int kGoldenReferenceBlockSize = 512;
+
+//==============================================================================
+/** One golden case: a stimulus rendered through a tank preset at a sample rate */
+struct GoldenCase
+{
+    juce::String stimulus;          // "impulse", "noise" or "sweep"
+    juce::String preset;            // "default", "sparse" or "long"
+    double sampleRate = 48000.0;
+
+    /** e.g. "sweep_sparse_48000" */
+    juce::String getName() const;
+
+    /** where the reference of this case lives in directory */
+    juce::File getReferenceFile(const juce::File& directory) const;
+};
+
+/** every stimulus with every preset at each of sampleRates */
+juce::Array<GoldenCase> getGoldenCases(const juce::Array<double>& sampleRates);
+
+/** The stereo input of a case, generated from fixed formulas and a fixed-seed generator so it is the
+    same on every platform and build:
+
+    "impulse" - a unit impulse on the left at 0 and on the right at 10 mSec, 3 seconds in all
+    "noise"   - 1 second of white noise (different on each channel) at -6 dBFS peak, then 2 seconds of silence
+    "sweep"   - a 2 second exponential sine sweep from 20 Hz to 20 kHz (or 0.45 * fs) at -6 dBFS on both
+                channels, then 1.5 seconds of silence
+*/
+juce::AudioBuffer<double> makeGoldenStimulus(const GoldenCase& goldenCase);
+
+/** The tank settings of a preset:
+
+    "default" - ReverbTankParameters as constructed (the plugin's defaults)
+    "sparse"  - sparse density, shorter reverb time, darker damping, both shelves boosting
+    "long"    - thick density, near-infinite reverb time, short pre-delay, flat shelves,
+                dry at -60 dB
+*/
+ReverbTankParameters getGoldenPreset(const juce::String& preset);
+
+//==============================================================================
+/** A reverb tank implementation to check against the references */
+struct TankVariant
+{
+    juce::String name;              // e.g. "ReverbTankSIMD<float>"
+    bool isDoublePrecision = true;
+
+    /** render buffer in place through a freshly reset tank, blockSize samples per processBlock( ) */
+    std::function<void(juce::AudioBuffer<double>& buffer, const ReverbTankParameters& params,
+                       double sampleRate, int blockSize)> render;
+};
+
+/** every variant; the first is the scalar double tank the references come from */
+std::vector<TankVariant> getTankVariants();
+
+/** render the reference output of a case */
+juce::AudioBuffer<double> renderGoldenReference(const GoldenCase& goldenCase);
+
+//==============================================================================
+/** Reference files hold the rendered output at full double precision: a "JVGR" tag, the format version,
+    the sample rate, channel and sample counts, then each channel's samples (all little-endian). */
+juce::Result writeGoldenFile(const juce::File& file, const juce::AudioBuffer<double>& output, double sampleRate);
+
+juce::Result readGoldenFile(const juce::File& file, juce::AudioBuffer<double>& output, double& sampleRate);
@@ -0,0 +1,312 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for JVerbGolden: golden-output
+    references rendered by the scalar double reverb tank, and the check of
+    every other tank variant against them.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "GoldenReference.h"
+#include "GoldenCompare.h"
+#include "ModulationCheck.h"
+
+//==============================================================================
+namespace
+{
+    /** take an option's value out of args; false if the option is not there */
+    bool removeOptionValue(juce::ArgumentList& args, juce::StringRef option, juce::String& value)
+    {
+        if (!args.containsOption(option))
+            return false;
+
+        value = args.removeValueForOption(option);
+        if (value.isEmpty())
+            juce::ConsoleApplication::fail(juce::String(option) + " needs a value");
+
+        return true;
+    }
+
+    /** a comma separated list of positive numbers */
+    template <typename ValueType>
+    juce::Array<ValueType> parseList(const juce::String& option, const juce::String& text)
+    {
+        juce::Array<ValueType> values;
+        for (auto& item : juce::StringArray::fromTokens(text, ",", ""))
+        {
+            auto value = (ValueType)item.trim().getDoubleValue();
+            if (value <= 0)
+                juce::ConsoleApplication::fail(option + " needs a list of positive numbers, not " + text.quoted());
+
+            values.add(value);
+        }
+
+        return values;
+    }
+
+    /** the reference directory: the value of the mode option, created when writing */
+    juce::File parseReferenceDirectory(juce::ArgumentList& args, const juce::String& mode, bool create)
+    {
+        juce::String value;
+        if (!removeOptionValue(args, mode, value))
+            juce::ConsoleApplication::fail(mode + " needs the reference directory");
+
+        auto directory = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+        if (create && !directory.createDirectory())
+            juce::ConsoleApplication::fail("cannot create " + directory.getFullPathName());
+
+        if (!directory.isDirectory())
+            juce::ConsoleApplication::fail(directory.getFullPathName() + " is not a directory");
+
+        return directory;
+    }
+
+    juce::Array<double> parseSampleRates(juce::ArgumentList& args)
+    {
+        juce::String value;
+        if (removeOptionValue(args, "--rates", value))
+            return parseList<double>("--rates", value);
+
+        // --- the rate of the reference set committed in Tools/JVerbGolden/References
+        return { 48000.0 };
+    }
+
+    void failOnUnusedArguments(const juce::ArgumentList& args)
+    {
+        for (auto& arg : args.arguments)
+            juce::ConsoleApplication::fail("unknown argument " + arg.text.quoted());
+    }
+
+    //==============================================================================
+    void writeReferences(const juce::ArgumentList& commandLine)
+    {
+        auto args = commandLine;
+        auto directory = parseReferenceDirectory(args, "--write", true);
+        auto sampleRates = parseSampleRates(args);
+        failOnUnusedArguments(args);
+
+        for (auto& goldenCase : getGoldenCases(sampleRates))
+        {
+            auto file = goldenCase.getReferenceFile(directory);
+            auto result = writeGoldenFile(file, renderGoldenReference(goldenCase), goldenCase.sampleRate);
+            if (result.failed())
+                juce::ConsoleApplication::fail(result.getErrorMessage());
+
+            std::cout << "wrote " << file.getFullPathName() << std::endl;
+        }
+    }
+
+    //==============================================================================
+    void checkVariants(const juce::ArgumentList& commandLine)
+    {
+        auto args = commandLine;
+        auto directory = parseReferenceDirectory(args, "--check", false);
+        auto sampleRates = parseSampleRates(args);
+
+        juce::Array<int> blockSizes { 1, 64, 512, 1013 };
+        juce::String value, variantFilter;
+        double maxError = -1.0, spectralDiff_dB = -1.0;
+
+        if (removeOptionValue(args, "--blocks", value))
+            blockSizes = parseList<int>("--blocks", value);
+
+        if (removeOptionValue(args, "--variants", value))
+            variantFilter = value;
+
+        if (removeOptionValue(args, "--tolerance", value))
+            maxError = juce::jmax(0.0, value.getDoubleValue());
+
+        if (removeOptionValue(args, "--spectral-tolerance", value))
+            spectralDiff_dB = juce::jmax(0.0, value.getDoubleValue());
+
+        if (!removeOptionValue(args, "--json", value))
+            value = "JVerbGolden-check.json";
+
+        auto reportFile = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+        failOnUnusedArguments(args);
+
+        juce::Array<juce::var> results;
+        int numFailed = 0;
+
+        for (auto& goldenCase : getGoldenCases(sampleRates))
+        {
+            juce::AudioBuffer<double> reference;
+            double referenceSampleRate = 0.0;
+
+            auto result = readGoldenFile(goldenCase.getReferenceFile(directory), reference, referenceSampleRate);
+            if (result.failed())
+                juce::ConsoleApplication::fail(result.getErrorMessage() + " (write the references with --write first)");
+
+            if (referenceSampleRate != goldenCase.sampleRate)
+                juce::ConsoleApplication::fail(goldenCase.getName() + " was rendered at " + juce::String(referenceSampleRate) + " Hz");
+
+            const auto stimulus = makeGoldenStimulus(goldenCase);
+            const auto params = getGoldenPreset(goldenCase.preset);
+
+            for (auto& variant : getTankVariants())
+            {
+                if (variantFilter.isNotEmpty() && !variant.name.containsIgnoreCase(variantFilter))
+                    continue;
+
+                auto tolerance = GoldenTolerance::forPrecision(variant.isDoublePrecision);
+                if (maxError >= 0.0)
+                    tolerance.maxError = maxError;
+                if (spectralDiff_dB >= 0.0)
+                    tolerance.spectralDiff_dB = spectralDiff_dB;
+
+                for (auto blockSize : blockSizes)
+                {
+                    auto output = stimulus;
+                    variant.render(output, params, goldenCase.sampleRate, blockSize);
+
+                    auto comparison = compareToGolden(reference, output);
+                    auto passed = comparison.passes(tolerance);
+                    if (!passed)
+                        numFailed++;
+
+                    std::cout << juce::String::formatted("%-22s %-24s %5d  max error %9.3g  rms error %7.1f dB  spectral max %8.4f dB  mean %8.5f dB  %s",
+                        goldenCase.getName().toRawUTF8(), variant.name.toRawUTF8(), blockSize, comparison.maxError,
+                        comparison.rmsError_dB, comparison.spectralMaxDiff_dB, comparison.spectralMeanDiff_dB,
+                        passed ? "ok" : (comparison.lengthsMatch ? "FAILED" : "FAILED (length)")) << std::endl;
+
+                    auto* item = new juce::DynamicObject();
+                    item->setProperty("case", goldenCase.getName());
+                    item->setProperty("variant", variant.name);
+                    item->setProperty("blockSize", blockSize);
+                    item->setProperty("maxError", comparison.maxError);
+                    item->setProperty("rmsError_dB", comparison.rmsError_dB);
+                    item->setProperty("spectralMaxDiff_dB", comparison.spectralMaxDiff_dB);
+                    item->setProperty("spectralMeanDiff_dB", comparison.spectralMeanDiff_dB);
+                    item->setProperty("toleranceMaxError", tolerance.maxError);
+                    item->setProperty("toleranceSpectralDiff_dB", tolerance.spectralDiff_dB);
+                    item->setProperty("passed", passed);
+                    results.add(item);
+                }
+            }
+        }
+
+        auto* report = new juce::DynamicObject();
+        report->setProperty("tool", "JVerbGolden");
+        report->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+        report->setProperty("references", directory.getFullPathName());
+        report->setProperty("numFailed", numFailed);
+        report->setProperty("results", results);
+
+        if (!reportFile.replaceWithText(juce::JSON::toString(juce::var(report))))
+            juce::ConsoleApplication::fail("cannot write " + reportFile.getFullPathName());
+
+        std::cout << "wrote " << reportFile.getFullPathName() << std::endl;
+
+        if (numFailed > 0)
+            juce::ConsoleApplication::fail(juce::String(numFailed) + " of " + juce::String(results.size()) + " comparisons failed");
+
+        std::cout << "all " << results.size() << " comparisons passed" << std::endl;
+    }
+
+    //==============================================================================
+    void checkModulation(const juce::ArgumentList& commandLine)
+    {
+        auto args = commandLine;
+        args.removeOptionIfFound("--check-modulation");
+        auto sampleRates = parseSampleRates(args);
+
+        juce::Array<int> blockSizes { 1, 64, 512, 1013 };
+        juce::Array<double> lfoRates;
+        for (auto lfoRate_Hz : kModulationCheckLFORates_Hz)
+            lfoRates.add(lfoRate_Hz);
+
+        juce::String value;
+        double tolerance_dB = kModulationCheckTolerance_dB;
+
+        if (removeOptionValue(args, "--blocks", value))
+            blockSizes = parseList<int>("--blocks", value);
+
+        if (removeOptionValue(args, "--lfo-rates", value))
+            lfoRates = parseList<double>("--lfo-rates", value);
+
+        if (removeOptionValue(args, "--tolerance", value))
+            tolerance_dB = value.getDoubleValue();
+
+        failOnUnusedArguments(args);
+
+        int numChecked = 0, numFailed = 0;
+
+        for (auto sampleRate : sampleRates)
+        {
+            // --- one channel per tank branch, each fed with one of the noise channels
+            const auto noise = makeGoldenStimulus({ "noise", "default", sampleRate });
+            juce::AudioBuffer<double> stimulus(NUM_BRANCHES, noise.getNumSamples());
+            for (int ch = 0; ch < NUM_BRANCHES; ch++)
+                stimulus.copyFrom(ch, 0, noise, ch % noise.getNumChannels(), 0, noise.getNumSamples());
+
+            for (auto lfoRate_Hz : lfoRates)
+            {
+                // --- the per-sample LFO is the reference; it does not depend on the block size
+                auto reference = stimulus;
+                renderModulatedAPFs(reference, sampleRate, lfoRate_Hz, 1, kGoldenReferenceBlockSize);
+
+                for (auto blockSize : blockSizes)
+                {
+                    auto output = stimulus;
+                    renderModulatedAPFs(output, sampleRate, lfoRate_Hz, kReverbTankLFOUpdateInterval, blockSize);
+
+                    auto comparison = compareToGolden(reference, output);
+                    auto passed = comparison.lengthsMatch && comparison.rmsError_dB <= tolerance_dB;
+                    numChecked++;
+                    if (!passed)
+                        numFailed++;
+
+                    std::cout << juce::String::formatted("%6d Hz  LFO %6.2f Hz  interval %2u vs 1  %5d  max error %9.3g  rms error %7.1f dB  %s",
+                        juce::roundToInt(sampleRate), lfoRate_Hz, kReverbTankLFOUpdateInterval, blockSize,
+                        comparison.maxError, comparison.rmsError_dB, passed ? "ok" : "FAILED") << std::endl;
+                }
+            }
+        }
+
+        if (numFailed > 0)
+            juce::ConsoleApplication::fail(juce::String(numFailed) + " of " + juce::String(numChecked) + " comparisons failed");
+
+        std::cout << "all " << numChecked << " comparisons passed" << std::endl;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand("--help|-h", "JVerb golden-output references", true);
+    app.addCommand({ "--write", "--write <dir> [--rates <list>]", "Render the golden references into dir",
+                     "Renders every stimulus (impulse, noise, sweep) through every preset (default, sparse, long) with the "
+                     "scalar double ReverbTank and stores the output at full precision, one .jvgr file per case. Run it on "
+                     "the build you trust, before the change you want to check.\n\n"
+                     "  --rates <list>               sample rates (default 48000)",
+                     writeReferences });
+    app.addCommand({ "--check", "--check <dir> [options]", "Check every tank variant against the references in dir",
+                     "Renders each case through every tank variant (scalar and SIMD branches, double and float) at each "
+                     "block size and compares the result with its reference: the largest sample error, the RMS error and "
+                     "the largest and mean difference of the short-time magnitude spectra. Fails if any comparison is out "
+                     "of tolerance. Results go to JVerbGolden-check.json unless --json says otherwise.\n\n"
+                     "  --rates <list>               sample rates (default 48000)\n"
+                     "  --blocks <list>              block sizes (default 1,64,512,1013)\n"
+                     "  --variants <text>            only check variants whose name contains text\n"
+                     "  --tolerance <error>          largest sample error allowed (default 1e-9 double, 1e-4 float)\n"
+                     "  --spectral-tolerance <dB>    largest spectral difference allowed (default 0.001 double, 0.1 float)\n"
+                     "  --json <file>                where to write the results",
+                     checkVariants });
+    app.addCommand({ "--check-modulation", "--check-modulation [options]", "Check the control-rate LFO modulation",
+                     "Renders noise through modulated APFs set up like the outer APFs of the tank branches, but with sine "
+                     "LFOs at a non-zero rate, once with the LFOs updated every sample and once every "
+                     "kReverbTankLFOUpdateInterval samples at each block size, and compares the two. Fails if the RMS "
+                     "error of any control-rate render is above the tolerance.\n\n"
+                     "  --rates <list>               sample rates (default 48000)\n"
+                     "  --blocks <list>              block sizes (default 1,64,512,1013)\n"
+                     "  --lfo-rates <list>           LFO rates in Hz (default 0.15,0.73,5)\n"
+                     "  --tolerance <dB>             largest RMS error allowed, relative to the per-sample render (default -60)",
+                     checkModulation });
+
+    return app.findAndRunCommand(argc, argv);
+}
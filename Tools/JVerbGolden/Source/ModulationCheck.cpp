@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    ModulationCheck.cpp
+
+  ==============================================================================
+*/
+
+#include "ModulationCheck.h"
+
+//==============================================================================
+void renderModulatedAPFs(juce::AudioBuffer<double>& buffer, double sampleRate, double lfoRate_Hz,
+                         unsigned int lfoUpdateInterval, int blockSize)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    const ReverbTankParameters tankParams;
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ch++)
+    {
+        const int branch = ch % NUM_BRANCHES;
+        const auto branchParams = getReverbTankAPFParameters(tankParams, branch);
+
+        auto apf = std::make_unique<DelayAPF<double>>();
+        apf->createDelayBuffer(sampleRate, kReverbTankAPFDelayMax_mSec * kReverbTankAPFDelayWeight[2 * branch]);
+        apf->reset(sampleRate);
+
+        DelayAPFParameters params = apf->getParameters();
+        params.delayTime_mSec = branchParams.outerAPFdelayTime_mSec;
+        params.apf_g = branchParams.outerAPF_g;
+        params.enableLFO = true;
+        params.lfoDepth = branchParams.lfoDepth;
+        params.lfoMaxModulation_mSec = branchParams.lfoMaxModulation_mSec;
+        params.lfoRate_Hz = lfoRate_Hz;
+        params.lfoUpdateInterval = lfoUpdateInterval;
+        params.interpolate = true;
+        apf->setParameters(params);
+
+        OscillatorParameters lfoParams = apf->getLFOParameters();
+        lfoParams.frequency_Hz = lfoRate_Hz;
+        lfoParams.waveform = generatorWaveform::kSin;
+        apf->setLFOParameters(lfoParams);
+
+        auto* samples = buffer.getWritePointer(ch);
+        for (int offset = 0; offset < buffer.getNumSamples(); offset += blockSize)
+        {
+            auto numSamples = juce::jmin(blockSize, buffer.getNumSamples() - offset);
+            apf->processBlock(samples + offset, samples + offset, numSamples);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    ModulationCheck.h
+    The check of the control-rate LFO modulation: modulated APFs that update
+    their LFO every few samples against the same APFs updated every sample.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/DSP/ReverbTank.h"
+
+//==============================================================================
+// --- the LFO rates checked unless told otherwise: the slowest and fastest tank branch, and a fast vibrato
+const double kModulationCheckLFORates_Hz[] = { 0.15, 0.73, 5.0 };
+
+// --- how far the control-rate render may stray from the per-sample one (RMS error relative to it)
+const double kModulationCheckTolerance_dB = -60.0;
+
+/** Renders buffer in place through one DelayAPF per channel, each set up like the outer APF of the tank branch
+    with the same index (delay time, g and modulation depth) but with a sine LFO at lfoRate_Hz and an interpolated
+    read, so the output follows the modulated delay time closely. The APFs are freshly reset and run blockSize
+    samples per processBlock( ).
+*/
+void renderModulatedAPFs(juce::AudioBuffer<double>& buffer, double sampleRate, double lfoRate_Hz,
+                         unsigned int lfoUpdateInterval, int blockSize);
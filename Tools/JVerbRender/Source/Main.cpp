@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for the JVerb offline renderer:
+    a command line tool that prints audio files through the reverb tank,
+    several files at once.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "OfflineRenderer.h"
+
+//==============================================================================
+namespace
+{
+    /** take an option's value out of args; false if the option is not there */
+    bool removeOptionValue(juce::ArgumentList& args, juce::StringRef option, juce::String& value)
+    {
+        if (!args.containsOption(option))
+            return false;
+
+        value = args.removeValueForOption(option);
+        if (value.isEmpty())
+            juce::ConsoleApplication::fail(juce::String(option) + " needs a value");
+
+        return true;
+    }
+
+    /** fill in RenderSettings from the options in args, removing them; the preset is applied before
+        any single parameter options, so those override it */
+    RenderSettings parseRenderSettings(juce::ArgumentList& args)
+    {
+        RenderSettings settings;
+        juce::String value;
+
+        if (removeOptionValue(args, "--preset", value))
+        {
+            auto result = loadTankPreset(settings.parameters, juce::File::getCurrentWorkingDirectory().getChildFile(value));
+            if (result.failed())
+                juce::ConsoleApplication::fail(result.getErrorMessage());
+        }
+
+        for (auto& name : getTankParameterNames())
+        {
+            if (removeOptionValue(args, "--" + name, value))
+            {
+                auto result = setTankParameter(settings.parameters, name, value);
+                if (result.failed())
+                    juce::ConsoleApplication::fail(result.getErrorMessage());
+            }
+        }
+
+        if (removeOptionValue(args, "--block-size", value))
+            settings.blockSize = juce::jmax(1, value.getIntValue());
+
+        if (removeOptionValue(args, "--max-tail", value))
+            settings.maxTail_Sec = juce::jmax(0.0, value.getDoubleValue());
+
+        if (removeOptionValue(args, "--tail-threshold", value))
+            settings.tailThreshold_dB = value.getDoubleValue();
+
+        if (removeOptionValue(args, "--out-dir", value))
+        {
+            settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(value);
+            if (!settings.outputDirectory.createDirectory())
+                juce::ConsoleApplication::fail("cannot create " + settings.outputDirectory.getFullPathName());
+        }
+
+        if (removeOptionValue(args, "--suffix", value))
+            settings.outputSuffix = value;
+
+        settings.useDoublePrecision = args.removeOptionIfFound("--double");
+        return settings;
+    }
+
+    void renderFiles(const juce::ArgumentList& commandLine)
+    {
+        auto args = commandLine;
+        auto settings = parseRenderSettings(args);
+
+        int numThreads = juce::SystemStats::getNumCpus();
+        juce::String value;
+        if (removeOptionValue(args, "--jobs", value))
+            numThreads = juce::jmax(1, value.getIntValue());
+
+        // --- whatever is left is the list of input files
+        juce::Array<juce::File> inputs;
+        for (auto& arg : args.arguments)
+        {
+            if (arg.isOption())
+                juce::ConsoleApplication::fail("unknown option " + arg.text);
+
+            inputs.add(arg.resolveAsExistingFile());
+        }
+
+        if (inputs.isEmpty())
+            juce::ConsoleApplication::fail("no input files (see --help)");
+
+        // --- one job per file; each job has its own renderer and reverb tank
+        juce::ThreadPool pool(juce::jmin(numThreads, inputs.size()));
+        juce::CriticalSection printLock;
+        std::atomic<int> numFailed { 0 };
+
+        for (auto& input : inputs)
+        {
+            pool.addJob([&, input]
+            {
+                OfflineRenderer renderer(settings);
+                auto output = OfflineRenderer::getOutputFile(input, settings);
+                auto result = renderer.render(input, output);
+
+                const juce::ScopedLock sl(printLock);
+                if (result.failed())
+                {
+                    std::cerr << "FAILED " << result.getErrorMessage() << std::endl;
+                    numFailed++;
+                }
+                else
+                {
+                    auto& stats = renderer.getStatistics();
+                    auto length_Sec = stats.outputLength_Samples / stats.sampleRate;
+                    std::cout << input.getFileName() << " -> " << output.getFullPathName()
+                              << juce::String::formatted(": %.1f s (%.1f s tail) in %.2f s, %.0fx real time",
+                                    length_Sec, (stats.outputLength_Samples - stats.inputLength_Samples) / stats.sampleRate,
+                                    stats.renderTime_Sec, length_Sec / juce::jmax(stats.renderTime_Sec, 1.0e-6))
+                              << std::endl;
+                }
+
+                return juce::ThreadPoolJob::jobHasFinished;
+            });
+        }
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+
+        if (numFailed > 0)
+            juce::ConsoleApplication::fail(juce::String(numFailed.load()) + " of " + juce::String(inputs.size()) + " files failed");
+    }
+
+    juce::String getRenderHelp()
+    {
+        return "Renders each file through the reverb tank, tail included, and writes <name>" + RenderSettings().outputSuffix
+            + ".<ext> next to it (or into --out-dir). Files are rendered in parallel.\n\n"
+              "  --preset <file>          plugin state XML (<Parameters><PARAM id=... value=.../>) to start from\n"
+              "  --<parameter> <value>    set a ReverbTankParameters member, after the preset; one of\n"
+              "                           " + getTankParameterNames().joinIntoString(", ") + "\n"
+              "  --block-size <n>         samples per processBlock( ) call (default 4096)\n"
+              "  --max-tail <sec>         longest tail after the input (default 10)\n"
+              "  --tail-threshold <dB>    the tail ends after 0.5 s below this level (default -96)\n"
+              "  --double                 run the tank in double precision\n"
+              "  --out-dir <dir>          where to write the results\n"
+              "  --suffix <text>          appended to the output file names (default _jverb)\n"
+              "  --jobs <n>               files rendered at once (default: number of CPUs)";
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand("--help|-h", "JVerb offline renderer", false);
+    app.addDefaultCommand({ "", "[options] <file> [<file> ...]", "Render audio files through JVerb",
+                            getRenderHelp(), renderFiles });
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer(const RenderSettings& _settings)
+    : settings(_settings)
+{
+    formatManager.registerBasicFormats();
+}
+
+juce::File OfflineRenderer::getOutputFile(const juce::File& input, const RenderSettings& settings)
+{
+    auto directory = settings.outputDirectory == juce::File() ? input.getParentDirectory() : settings.outputDirectory;
+    return directory.getChildFile(input.getFileNameWithoutExtension() + settings.outputSuffix + input.getFileExtension());
+}
+
+juce::Result OfflineRenderer::render(const juce::File& input, const juce::File& output)
+{
+    statistics = Statistics();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(input));
+    if (reader == nullptr)
+        return juce::Result::fail(input.getFullPathName() + ": not a readable audio file");
+
+    if (reader->numChannels < 1 || reader->numChannels > NUM_CHANNELS)
+        return juce::Result::fail(input.getFullPathName() + ": only mono and stereo files are supported");
+
+    auto* format = formatManager.findFormatForFileExtension(output.getFileExtension());
+    if (format == nullptr)
+        return juce::Result::fail(output.getFullPathName() + ": no audio format for this file extension");
+
+    // --- keep the input's bit depth if the output format can write it
+    int bitsPerSample = (int)reader->bitsPerSample;
+    if (!format->getPossibleBitDepths().contains(bitsPerSample))
+        bitsPerSample = 24;
+
+    output.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream(output.createOutputStream());
+    if (stream == nullptr)
+        return juce::Result::fail(output.getFullPathName() + ": cannot write to this file");
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), reader->sampleRate,
+        reader->numChannels, bitsPerSample, reader->metadataValues, 0));
+    if (writer == nullptr)
+        return juce::Result::fail(output.getFullPathName() + ": cannot write this sample rate or channel count");
+
+    // --- the writer owns the stream now
+    stream.release();
+
+    auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    if (settings.useDoublePrecision)
+        process<double>(*reader, *writer);
+    else
+        process<float>(*reader, *writer);
+
+    statistics.renderTime_Sec = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    return juce::Result::ok();
+}
+
+template <typename SampleType>
+void OfflineRenderer::process(juce::AudioFormatReader& reader, juce::AudioFormatWriter& writer)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    const int numChannels = (int)reader.numChannels;
+    const int blockSize = juce::jmax(1, settings.blockSize);
+    const double sampleRate = reader.sampleRate;
+
+    // --- start from silence at the target levels: flush( ) skips the gain and shelf ramps a
+    //     parameter change would otherwise start at the top of the file
+    auto reverb = std::make_unique<ReverbTankSIMD<SampleType>>();
+    reverb->reset(sampleRate);
+    reverb->setParameters(settings.parameters);
+    reverb->flush();
+
+    juce::AudioBuffer<float> ioBuffer(numChannels, blockSize);
+    juce::AudioBuffer<SampleType> reverbBuffer(numChannels, blockSize);
+
+    const juce::int64 inputLength = reader.lengthInSamples;
+    const juce::int64 maxLength = inputLength + (juce::int64)(settings.maxTail_Sec * sampleRate);
+    const juce::int64 tailQuietLength = (juce::int64)(settings.tailQuietTime_Sec * sampleRate);
+    const float tailThreshold = juce::Decibels::decibelsToGain((float)settings.tailThreshold_dB);
+
+    juce::int64 position = 0;
+    juce::int64 quietLength = 0;
+
+    while (position < maxLength)
+    {
+        auto numSamples = (int)juce::jmin((juce::int64)blockSize, maxLength - position);
+
+        // --- input, then silence for the tail
+        ioBuffer.clear();
+        if (position < inputLength)
+            reader.read(&ioBuffer, 0, (int)juce::jmin((juce::int64)numSamples, inputLength - position), position, true, true);
+
+        reverbBuffer.makeCopyOf(ioBuffer, true);
+        reverb->processBlock(reverbBuffer.getArrayOfReadPointers(), reverbBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+        ioBuffer.makeCopyOf(reverbBuffer, true);
+
+        writer.writeFromAudioSampleBuffer(ioBuffer, 0, numSamples);
+        position += numSamples;
+
+        // --- once past the input, stop when the tail has been quiet for long enough
+        if (position - numSamples >= inputLength)
+        {
+            if (ioBuffer.getMagnitude(0, numSamples) < tailThreshold)
+                quietLength += numSamples;
+            else
+                quietLength = 0;
+
+            if (quietLength >= tailQuietLength)
+                break;
+        }
+    }
+
+    statistics.inputLength_Samples = inputLength;
+    statistics.outputLength_Samples = position;
+    statistics.sampleRate = sampleRate;
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Renders audio files through the reverb tank, tail included.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "RenderSettings.h"
+
+//==============================================================================
+/**
+    Renders one file at a time through its own ReverbTankSIMD, so one OfflineRenderer per thread can run
+    in parallel. The input is read and processed in blocks of RenderSettings::blockSize; after the end of
+    the input, silence is fed in until the tail has died away (or maxTail_Sec is reached).
+
+    Mono and stereo files are supported; the output has the same format, sample rate, channel count and
+    (where the format allows it) bit depth as the input.
+*/
+class OfflineRenderer
+{
+public:
+    explicit OfflineRenderer(const RenderSettings& settings);
+
+    /** the statistics of the last render( ) */
+    struct Statistics
+    {
+        juce::int64 inputLength_Samples = 0;
+        juce::int64 outputLength_Samples = 0;
+        double sampleRate = 0.0;
+        double renderTime_Sec = 0.0;
+    };
+
+    /** render input to output, replacing output if it exists */
+    juce::Result render(const juce::File& input, const juce::File& output);
+
+    /** where render( ) puts the result of an input file with these settings */
+    static juce::File getOutputFile(const juce::File& input, const RenderSettings& settings);
+
+    const Statistics& getStatistics() const { return statistics; }
+
+private:
+    template <typename SampleType>
+    void process(juce::AudioFormatReader& reader, juce::AudioFormatWriter& writer);
+
+    const RenderSettings settings;
+    juce::AudioFormatManager formatManager;
+    Statistics statistics;
+
+    JUCE_DECLARE_NON_COPYABLE(OfflineRenderer)
+};
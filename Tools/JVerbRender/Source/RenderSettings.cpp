@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    RenderSettings.cpp
+
+  ==============================================================================
+*/
+
+#include "RenderSettings.h"
+
+//==============================================================================
+namespace
+{
+    struct TankParameterInfo
+    {
+        const char* name;
+        double ReverbTankParameters::* member;
+    };
+
+    // --- every double member of ReverbTankParameters, by name
+    const TankParameterInfo kTankParameters[] =
+    {
+        { "apfDelayMax_mSec",       &ReverbTankParameters::apfDelayMax_mSec },
+        { "apfDelayWeight_Pct",     &ReverbTankParameters::apfDelayWeight_Pct },
+        { "fixeDelayMax_mSec",      &ReverbTankParameters::fixeDelayMax_mSec },
+        { "fixeDelayWeight_Pct",    &ReverbTankParameters::fixeDelayWeight_Pct },
+        { "preDelayTime_mSec",      &ReverbTankParameters::preDelayTime_mSec },
+        { "lpf_g",                  &ReverbTankParameters::lpf_g },
+        { "kRT",                    &ReverbTankParameters::kRT },
+        { "lowShelf_fc",            &ReverbTankParameters::lowShelf_fc },
+        { "lowShelfBoostCut_dB",    &ReverbTankParameters::lowShelfBoostCut_dB },
+        { "highShelf_fc",           &ReverbTankParameters::highShelf_fc },
+        { "highShelfBoostCut_dB",   &ReverbTankParameters::highShelfBoostCut_dB },
+        { "wetLevel_dB",            &ReverbTankParameters::wetLevel_dB },
+        { "dryLevel_dB",            &ReverbTankParameters::dryLevel_dB },
+    };
+}
+
+//==============================================================================
+juce::Result setTankParameter(ReverbTankParameters& params, const juce::String& name, const juce::String& value)
+{
+    if (name == "density")
+    {
+        if (value.equalsIgnoreCase("thick") || value == "0")
+            params.density = reverbDensity::kThick;
+        else if (value.equalsIgnoreCase("sparse") || value == "1")
+            params.density = reverbDensity::kSparse;
+        else
+            return juce::Result::fail("density must be thick or sparse, not " + value.quoted());
+
+        return juce::Result::ok();
+    }
+
+    for (auto& info : kTankParameters)
+    {
+        if (name == info.name)
+        {
+            if (!value.trim().containsOnly("0123456789+-.eE") || value.trim().isEmpty())
+                return juce::Result::fail(name + " needs a number, not " + value.quoted());
+
+            params.*info.member = value.getDoubleValue();
+            return juce::Result::ok();
+        }
+    }
+
+    return juce::Result::fail("unknown parameter " + name.quoted());
+}
+
+juce::Result loadTankPreset(ReverbTankParameters& params, const juce::File& presetFile)
+{
+    auto xml = juce::XmlDocument::parse(presetFile);
+    if (xml == nullptr)
+        return juce::Result::fail(presetFile.getFullPathName() + " is not an XML file");
+
+    for (auto* param : xml->getChildWithTagNameIterator("PARAM"))
+    {
+        auto result = setTankParameter(params, param->getStringAttribute("id"), param->getStringAttribute("value"));
+        if (result.failed())
+            return juce::Result::fail(presetFile.getFileName() + ": " + result.getErrorMessage());
+    }
+
+    return juce::Result::ok();
+}
+
+juce::StringArray getTankParameterNames()
+{
+    juce::StringArray names { "density" };
+
+    for (auto& info : kTankParameters)
+        names.add(info.name);
+
+    return names;
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    RenderSettings.h
+    Settings for an offline render: the reverb tank parameters (from a preset
+    and/or the command line) and how the files are rendered.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/DSP/ReverbTank.h"
+
+//==============================================================================
+struct RenderSettings
+{
+    ReverbTankParameters parameters;
+
+    int blockSize = 4096;                   // samples handed to the tank per processBlock( ) call
+    bool useDoublePrecision = false;        // run the tank in double (the plugin runs in the host's precision)
+
+    double maxTail_Sec = 10.0;              // longest tail rendered after the end of the input
+    double tailThreshold_dB = -96.0;        // the tail ends once the output stays below this...
+    double tailQuietTime_Sec = 0.5;         // ...for this long
+
+    juce::File outputDirectory;             // empty: next to each input file
+    juce::String outputSuffix = "_jverb";   // appended to the input file name
+};
+
+//==============================================================================
+/** Sets a ReverbTankParameters member by name; the names are the member names, which are also the
+    parameter IDs the plugin saves in its state. density takes "thick" or "sparse" (or 0 / 1). */
+juce::Result setTankParameter(ReverbTankParameters& params, const juce::String& name, const juce::String& value);
+
+/** Loads a preset: the plugin's saved state XML (<Parameters><PARAM id="kRT" value="0.9"/>...) or any XML
+    element with PARAM children naming ReverbTankParameters members. Parameters not in the file are left alone. */
+juce::Result loadTankPreset(ReverbTankParameters& params, const juce::File& presetFile);
+
+/** The names setTankParameter( ) accepts, for the help text */
+juce::StringArray getTankParameterNames();